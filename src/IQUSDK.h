@@ -1,6 +1,44 @@
 #import <Foundation/Foundation.h>
 #import "IQUSDKIDType.h"
 #import "IQUSDKTestMode.h"
+#import "IQUSDKWireFormat.h"
+
+#pragma mark - Consts
+
+/**
+  Event type of revenue events, see trackRevenue:currency:. Revenue events are always protected.
+*/
+extern NSString* const IQUSDKEventRevenue;
+
+/**
+  Event type of item purchase events, see trackItemPurchase:.
+*/
+extern NSString* const IQUSDKEventItemPurchase;
+
+/**
+  Event type of tutorial events, see trackTutorial:.
+*/
+extern NSString* const IQUSDKEventTutorial;
+
+/**
+  Event type of milestone events, see trackMilestone:value:.
+*/
+extern NSString* const IQUSDKEventMilestone;
+
+/**
+  Event type of marketing events, see trackMarketing:campaign:ad:subID:subSubID:.
+*/
+extern NSString* const IQUSDKEventMarketing;
+
+/**
+  Event type of user attribute events, see trackUserAttribute:value:.
+*/
+extern NSString* const IQUSDKEventUserAttribute;
+
+/**
+  Event type of country events, see trackCountry:.
+*/
+extern NSString* const IQUSDKEventCountry;
 
 #pragma mark - INTERFACE
 
@@ -242,6 +280,65 @@
 */
 - (void)trackCountry:(NSString*)aCountry;
 
+#pragma mark - Event limit methods
+
+/**
+  Limits the number of events of a certain type that are tracked, using a token bucket. Events exceeding the limit are
+  ignored and counted, see getSuppressedCount:.
+
+  Revenue events and event types passed to protect: are never limited.
+
+  Use one of the IQUSDKEvent constants for the event type, e.g. IQUSDKEventMilestone.
+
+  @param anEventType Event type to limit
+  @param aRate Number of events per second allowed on average, use 0 to remove the limit.
+  @param aBurst Maximum number of events allowed in a short burst.
+*/
+- (void)setRateLimit:(NSString*)anEventType rate:(double)aRate burst:(int)aBurst;
+
+/**
+  Tracks events of a certain type only for a fraction of the users. The decision is based on the SDK ID, so a user
+  either tracks all events of the type or none. Ignored events are counted, see getSuppressedCount:.
+
+  Revenue events and event types passed to protect: are never sampled.
+
+  @param anEventType Event type to sample (one of the IQUSDKEvent constants)
+  @param aRate Fraction of users that track the event type (0.0 - 1.0), the default is 1.0.
+*/
+- (void)setSampleRate:(NSString*)anEventType rate:(double)aRate;
+
+/**
+  Protects events of a certain type, they are always tracked regardless of any rate limit or sample rate.
+
+  Revenue events are always protected.
+
+  @param anEventType Event type to protect (one of the IQUSDKEvent constants)
+*/
+- (void)protect:(NSString*)anEventType;
+
+/**
+  Returns the number of events of a certain type that were ignored because of a rate limit or sampling.
+
+  @param anEventType Event type to get count for (one of the IQUSDKEvent constants)
+
+  @return number of suppressed events.
+*/
+- (int64_t)getSuppressedCount:(NSString*)anEventType;
+
+#pragma mark - Dead letter methods
+
+/**
+  Returns the number of messages the server rejected that are kept, see maxDeadLetterCount.
+
+  @return number of rejected messages or 0 if the IQU SDK has not been initialized.
+*/
+- (int)getDeadLetterCount;
+
+/**
+  Removes all messages the server rejected, including the persistently stored ones.
+*/
+- (void)clearDeadLetters;
+
 #pragma mark - Public methods for internal use
 
 /**
@@ -307,6 +404,60 @@
 */
 @property (nonatomic) int checkServerInterval;
 
+/**
+  This property determines the maximum time in milliseconds the SDK uses to finish sending when the application moves
+  to the background or terminates.
+
+  A send that is in progress is allowed to finish within this time. If at least one second is left, one more small
+  batch of pending messages (revenue messages first) is sent. The remaining messages are stored and sent later.
+
+  The drain blocks the thread handling the background or terminate notification (the main thread on iOS) for up to
+  this time. Keep it well below the time the OS allows for handling these notifications (about 5 seconds on iOS).
+
+  Use 0 to cancel any send immediately.
+
+  The default value is 3000 (3 seconds).
+*/
+@property (nonatomic) int drainTimeout;
+
+/**
+  This property determines the time in milliseconds between heartbeat messages.
+
+  The default value is 60000 (1 minute).
+*/
+@property (nonatomic) int heartbeatInterval;
+
+/**
+  This property determines the URL of the server messages are sent to.
+
+  Change this property to send the messages to another server, for example a local server used while testing.
+
+  The default value is "https://tracker.iqugroup.com/v3/".
+*/
+@property (nonatomic) NSString* serverURL;
+
+/**
+  This property determines the format used to send messages to the server.
+
+  Use IQUSDKWireFormatGrouped with servers that support it, to send every distinct set of ids only once per batch.
+
+  The default value is IQUSDKWireFormatList.
+*/
+@property (nonatomic) IQUSDKWireFormat wireFormat;
+
+/**
+  This property determines the maximum number of messages that are kept after the server rejected them.
+
+  The server can accept or reject individual messages. Rejected messages are not sent again but are moved to a separate
+  persistently stored queue. When this queue is full the oldest rejected message is removed.
+
+  Lowering the value removes the oldest kept messages. A value of 0 or less keeps no rejected messages, they are
+  discarded right away and any kept messages are removed. See also getDeadLetterCount and clearDeadLetters.
+
+  The default value is 100.
+*/
+@property (nonatomic) int maxDeadLetterCount;
+
 /**
   Turns the log on or off. When turned on, various IQU SDK methods will add information to the log property.
 
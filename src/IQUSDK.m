@@ -1,12 +1,13 @@
 #import "IQUSDKConfig.h"
 #import "IQUSDK.h"
+#import "IQUSDKEventLimiter.h"
 #import "IQUSDKIDs.h"
 #import "IQUSDKLocalStorage.h"
 #import "IQUSDKMessageQueue.h"
 #import "IQUSDKMessage.h"
 #import "IQUSDKNetwork.h"
 #import "IQUSDKUtils.h"
-#ifdef TARGET_OS_IPHONE
+#if TARGET_OS_IPHONE
 @import UIKit;
 @import CoreTelephony;
 #endif
@@ -72,6 +73,16 @@
 */
 @property IQUSDKMessageQueue* m_sendingMessages;
 
+/**
+  Contains messages that were rejected by the server.
+*/
+@property IQUSDKMessageQueue* m_deadLetterMessages;
+
+/**
+  Rate limits and sampling per event type.
+*/
+@property IQUSDKEventLimiter* m_eventLimiter;
+
 /**
   Time before a new server check is allowed.
 */
@@ -169,9 +180,20 @@
 
 /**
   Pauses the update thread, set thread paused to true and wait for the
-  update thread to finish.
+  update thread to finish. If the update thread is still busy at aDeadline,
+  any IO is cancelled.
+ 
+  @param aDeadline Time in milliseconds until which an active update call
+                   may continue.
 */
-- (void)pauseUpdateThread;
+- (void)pauseUpdateThread:(int64_t)aDeadline;
+
+/**
+  Pauses the update thread within drainTimeout milliseconds (letting an active
+  send finish) and uses the remaining time to send a small batch of pending
+  messages.
+*/
+- (void)drainUpdateThread;
 
 /**
   Resumes the paused thread.
@@ -183,6 +205,16 @@
 */
 - (void)waitForUpdateThread;
 
+/**
+  Waits for the update thread to finish to current update call or until a
+  certain time.
+ 
+  @param aDeadline Time in milliseconds to stop waiting at.
+ 
+  @return <code>true</code> if the update thread is no longer busy.
+*/
+- (bool)waitForUpdateThread:(int64_t)aDeadline;
+
 #pragma mark - Private message related methods
 
 /**
@@ -191,14 +223,25 @@
 - (void)processPendingMessages;
 
 /**
-  Tries to send the messages to the server. When successful the messages
-  get destroyed, else the messages get saved. This method will also update
-  the serverAvailable property.
+  Tries to send the messages to the server. Messages accepted by the server
+  get destroyed, rejected messages are moved to the dead letter queue and
+  the remaining messages get saved. This method will also update the
+  serverAvailable property.
  
   @param aMessages Messages to send to the server.
 */
 - (void)sendMessages:(IQUSDKMessageQueue*)aMessages;
 
+/**
+  Sends a small batch of pending messages, revenue messages first. Messages
+  that could not be sent are returned to the pending messages.
+ 
+  This method should only be called while the update thread is paused.
+ 
+  @param aDeadline Time in milliseconds sending must be finished by.
+*/
+- (void)sendPriorityMessages:(int64_t)aDeadline;
+
 /**
   Adds a message to the pending message list. The method is thread safe
   blocking any access to the pending message queue while it's busy adding
@@ -210,6 +253,16 @@
 
 #pragma mark - Private event related methods
 
+/**
+  Checks if an event of a certain type can be tracked. Events can not be tracked if analytics is disabled, the SDK is
+  not initialized or the event is suppressed by a rate limit or sampling.
+ 
+  @param anEventType Type of event to check
+ 
+  @return <code>true</code> if the event can be tracked, <code>false</code> if not.
+*/
+- (bool)canTrack:(NSString*)anEventType;
+
 /**
   Creates a message from an event and add it to the pending queue.
  
@@ -266,7 +319,8 @@
 #pragma mark - Event handlers
 
 /**
-  Handles the application being switched to the background. Pause the update thread and save any pending messages.
+  Handles the application being switched to the background. Drain and pause the update thread and save any pending
+  messages.
 */
 - (void)handleEnterBackground;
 
@@ -276,12 +330,22 @@
 - (void)handleEnterForeground;
 
 /**
-  Handles the application terminating. Destroy the update the instance and save any pending messages.
+  Handles the application terminating. Drain and destroy the update thread and save any pending messages.
 */
 - (void)handleTerminate;
 
 @end
 
+#pragma mark - Public consts
+
+NSString* const IQUSDKEventRevenue = @"revenue";
+NSString* const IQUSDKEventItemPurchase = @"item_purchase";
+NSString* const IQUSDKEventTutorial = @"tutorial";
+NSString* const IQUSDKEventMilestone = @"milestone";
+NSString* const IQUSDKEventMarketing = @"marketing";
+NSString* const IQUSDKEventUserAttribute = @"user_attribute";
+NSString* const IQUSDKEventCountry = @"country";
+
 #pragma mark - IMPLEMENTATION
 
 @implementation IQUSDK
@@ -298,9 +362,14 @@
 @synthesize updateInterval = _updateInterval;
 @synthesize sendTimeout = _sendTimeout;
 @synthesize checkServerInterval = _checkServerInterval;
+@synthesize heartbeatInterval = _heartbeatInterval;
+@synthesize drainTimeout = _drainTimeout;
 @synthesize logEnabled = _logEnabled;
 @synthesize testMode = _testMode;
 @synthesize serverAvailable = _serverAvailable;
+@synthesize serverURL = _serverURL;
+@synthesize wireFormat = _wireFormat;
+@synthesize maxDeadLetterCount = _maxDeadLetterCount;
 
 #pragma mark - Static variables
 
@@ -332,21 +401,51 @@ static const int DefaultSendTimeout = 20000;
 static const int DefaultCheckServerInterval = 2000;
 
 /**
-  Interval in milliseconds between heartbeat messages
+  Initial server URL value
 */
-static const int HeartbeatInterval = 60000;
+static NSString* const DefaultServerURL = @"https://tracker.iqugroup.com/v3/";
 
 /**
-  Event type values.
+  Initial maximum number of rejected messages to keep
+*/
+static const int DefaultMaxDeadLetterCount = 100;
+
+/**
+  Name of file where rejected messages are stored.
+*/
+static NSString* const DeadLetterFileName = @"IQUSDK_dead_letters.bin";
+
+/**
+  Initial maximum time in milliseconds to finish sending when moving to the background or terminating
+*/
+static const int DefaultDrainTimeout = 3000;
+
+/**
+  Maximum number of messages sent while draining
+*/
+static const int DrainBatchSize = 20;
+
+/**
+  Minimum time in milliseconds that must be left to send a batch while draining. With less time the server might
+  accept the batch while the send times out, causing the batch to be sent again later.
+*/
+static const int DrainMinSendTime = 1000;
+
+/**
+  Name used for the messages sent while draining. The batch is never saved, the name only prevents it from deleting
+  the file containing the pending messages.
+*/
+static NSString* const DrainFileName = @"IQUSDK_drain.bin";
+
+/**
+  Initial interval in milliseconds between heartbeat messages
+*/
+static const int DefaultHeartbeatInterval = 60000;
+
+/**
+  Event type values only used internally.
 */
-static NSString* const EventRevenue = @"revenue";
 static NSString* const EventHeartbeat = @"heartbeat";
-static NSString* const EventItemPurchase = @"item_purchase";
-static NSString* const EventTutorial = @"tutorial";
-static NSString* const EventMilestone = @"milestone";
-static NSString* const EventMarketing = @"marketing";
-static NSString* const EventUserAttribute = @"user_attribute";
-static NSString* const EventCountry = @"country";
 static NSString* const EventPlatform = @"platform";
 
 #pragma mark - Initializers
@@ -360,14 +459,22 @@ static NSString* const EventPlatform = @"platform";
     // initialize public properties
     self->_analyticsEnabled = true;
     self->_checkServerInterval = DefaultCheckServerInterval;
+    self->_drainTimeout = DefaultDrainTimeout;
+    self->_heartbeatInterval = DefaultHeartbeatInterval;
     self->_initialized = false;
     self->_logEnabled = false;
+    self->_maxDeadLetterCount = DefaultMaxDeadLetterCount;
     self->_sendTimeout = DefaultSendTimeout;
     self->_serverAvailable = true;
+    self->_serverURL = DefaultServerURL;
     self->_testMode = IQUSDKTestModeNone;
     self->_updateInterval = DefaultUpdateInterval;
+    self->_wireFormat = IQUSDKWireFormatList;
     // initialize private properties
     self.m_checkServerTime = 0;
+    self.m_deadLetterMessages = nil;
+    self.m_eventLimiter = [[IQUSDKEventLimiter alloc] init];
+    [self.m_eventLimiter protect:IQUSDKEventRevenue];
     self.m_firstUpdateCall = true;
     self.m_heartbeatTime = 0;
     self.m_ids = [[IQUSDKIDs alloc] init];
@@ -516,11 +623,11 @@ static NSString* const EventPlatform = @"platform";
   Implements the trackRevenue method.
 */
 - (void)trackRevenue:(float)anAmount currency:(NSString*)aCurrency reward:(NSString*)aReward {
-  // exit if not enabled or not initialized yet
-  if (!self.analyticsEnabled || !self.initialized) {
+  // exit if not enabled, not initialized yet or the event is suppressed
+  if (![self canTrack:IQUSDKEventRevenue]) {
     return;
   }
-  NSMutableDictionary* event = [self createEvent:EventRevenue];
+  NSMutableDictionary* event = [self createEvent:IQUSDKEventRevenue];
   [event setObject:@(anAmount) forKey:@"amount"];
   [event setObject:aCurrency forKey:@"currency"];
   if (aReward != nil) {
@@ -543,11 +650,11 @@ static NSString* const EventPlatform = @"platform";
             currency:(NSString*)aCurrency
      virtualCurrency:(float)aVirtualCurrencyAmount
               reward:(NSString*)aReward {
-  // exit if not enabled or not initialized yet
-  if (!self.analyticsEnabled || !self.initialized) {
+  // exit if not enabled, not initialized yet or the event is suppressed
+  if (![self canTrack:IQUSDKEventRevenue]) {
     return;
   }
-  NSMutableDictionary* event = [self createEvent:EventRevenue];
+  NSMutableDictionary* event = [self createEvent:IQUSDKEventRevenue];
   [event setObject:@(anAmount) forKey:@"amount"];
   [event setObject:aCurrency forKey:@"currency"];
   [event setObject:@(aVirtualCurrencyAmount) forKey:@"vc_amount"];
@@ -568,11 +675,11 @@ static NSString* const EventPlatform = @"platform";
   Implements the trackItemPurchase method.
 */
 - (void)trackItemPurchase:(NSString*)aName {
-  // exit if not enabled or not initialized yet
-  if (!self.analyticsEnabled || !self.initialized) {
+  // exit if not enabled, not initialized yet or the event is suppressed
+  if (![self canTrack:IQUSDKEventItemPurchase]) {
     return;
   }
-  NSMutableDictionary* event = [self createEvent:EventItemPurchase];
+  NSMutableDictionary* event = [self createEvent:IQUSDKEventItemPurchase];
   [event setObject:aName forKey:@"name"];
   [self addEvent:event];
 }
@@ -581,11 +688,11 @@ static NSString* const EventPlatform = @"platform";
   Implements the trackPurchase method.
 */
 - (void)trackItemPurchase:(NSString*)aName virtualCurrency:(float)aVirtualCurrencyAmount {
-  // exit if not enabled or not initialized yet
-  if (!self.analyticsEnabled || !self.initialized) {
+  // exit if not enabled, not initialized yet or the event is suppressed
+  if (![self canTrack:IQUSDKEventItemPurchase]) {
     return;
   }
-  NSMutableDictionary* event = [self createEvent:EventItemPurchase];
+  NSMutableDictionary* event = [self createEvent:IQUSDKEventItemPurchase];
   [event setObject:aName forKey:@"name"];
   [event setObject:@(aVirtualCurrencyAmount) forKey:@"vc_amount"];
   [self addEvent:event];
@@ -595,11 +702,11 @@ static NSString* const EventPlatform = @"platform";
   Implements the trackTutorial method.
 */
 - (void)trackTutorial:(NSString*)aStep {
-  // exit if not enabled or not initialized yet
-  if (!self.analyticsEnabled || !self.initialized) {
+  // exit if not enabled, not initialized yet or the event is suppressed
+  if (![self canTrack:IQUSDKEventTutorial]) {
     return;
   }
-  NSMutableDictionary* event = [self createEvent:EventTutorial];
+  NSMutableDictionary* event = [self createEvent:IQUSDKEventTutorial];
   [event setObject:aStep forKey:@"step"];
   [self addEvent:event];
 }
@@ -608,11 +715,11 @@ static NSString* const EventPlatform = @"platform";
   Implements the trackMilestone method.
 */
 - (void)trackMilestone:(NSString*)aName value:(NSString*)aValue {
-  // exit if not enabled or not initialized yet
-  if (!self.analyticsEnabled || !self.initialized) {
+  // exit if not enabled, not initialized yet or the event is suppressed
+  if (![self canTrack:IQUSDKEventMilestone]) {
     return;
   }
-  NSMutableDictionary* event = [self createEvent:EventMilestone];
+  NSMutableDictionary* event = [self createEvent:IQUSDKEventMilestone];
   [event setObject:aName forKey:@"name"];
   [event setObject:aValue forKey:@"value"];
   [self addEvent:event];
@@ -626,11 +733,11 @@ static NSString* const EventPlatform = @"platform";
                     ad:(NSString*)anAd
                  subID:(NSString*)aSubID
               subSubID:(NSString*)aSubSubID {
-  // exit if not enabled or not initialized yet
-  if (!self.analyticsEnabled || !self.initialized) {
+  // exit if not enabled, not initialized yet or the event is suppressed
+  if (![self canTrack:IQUSDKEventMarketing]) {
     return;
   }
-  NSMutableDictionary* event = [self createEvent:EventMarketing];
+  NSMutableDictionary* event = [self createEvent:IQUSDKEventMarketing];
   if (aPartner != nil) {
     [event setObject:aPartner forKey:@"partner"];
   }
@@ -653,11 +760,11 @@ static NSString* const EventPlatform = @"platform";
   Implements the trackUserAttribute method.
 */
 - (void)trackUserAttribute:(NSString*)aName value:(NSString*)aValue {
-  // exit if not enabled or not initialized yet
-  if (!self.analyticsEnabled || !self.initialized) {
+  // exit if not enabled, not initialized yet or the event is suppressed
+  if (![self canTrack:IQUSDKEventUserAttribute]) {
     return;
   }
-  NSMutableDictionary* event = [self createEvent:EventUserAttribute];
+  NSMutableDictionary* event = [self createEvent:IQUSDKEventUserAttribute];
   [event setObject:aName forKey:@"name"];
   [event setObject:aValue forKey:@"value"];
   [self addEvent:event];
@@ -667,15 +774,72 @@ static NSString* const EventPlatform = @"platform";
   Implements the trackCountry method.
 */
 - (void)trackCountry:(NSString*)aCountry {
-  // exit if not enabled or not initialized yet
-  if (!self.analyticsEnabled || !self.initialized) {
+  // exit if not enabled, not initialized yet or the event is suppressed
+  if (![self canTrack:IQUSDKEventCountry]) {
     return;
   }
-  NSMutableDictionary* event = [self createEvent:EventCountry];
+  NSMutableDictionary* event = [self createEvent:IQUSDKEventCountry];
   [event setObject:aCountry forKey:@"value"];
   [self addEvent:event];
 }
 
+#pragma mark - Public event limit methods
+
+/**
+  Implements the setRateLimit method.
+*/
+- (void)setRateLimit:(NSString*)anEventType rate:(double)aRate burst:(int)aBurst {
+  [self.m_eventLimiter setRateLimit:anEventType rate:aRate burst:aBurst];
+}
+
+/**
+  Implements the setSampleRate method.
+*/
+- (void)setSampleRate:(NSString*)anEventType rate:(double)aRate {
+  [self.m_eventLimiter setSampleRate:anEventType rate:aRate];
+}
+
+/**
+  Implements the protect method.
+*/
+- (void)protect:(NSString*)anEventType {
+  [self.m_eventLimiter protect:anEventType];
+}
+
+/**
+  Implements the getSuppressedCount method.
+*/
+- (int64_t)getSuppressedCount:(NSString*)anEventType {
+  return [self.m_eventLimiter getSuppressedCount:anEventType];
+}
+
+#pragma mark - Public dead letter methods
+
+/**
+  Implements the getDeadLetterCount method.
+*/
+- (int)getDeadLetterCount {
+  IQUSDKMessageQueue* deadLetters = self.m_deadLetterMessages;
+  if (deadLetters == nil) {
+    return 0;
+  }
+  @synchronized(deadLetters) {
+    return [deadLetters getCount];
+  }
+}
+
+/**
+  Implements the clearDeadLetters method.
+*/
+- (void)clearDeadLetters {
+  IQUSDKMessageQueue* deadLetters = self.m_deadLetterMessages;
+  if (deadLetters != nil) {
+    @synchronized(deadLetters) {
+      [deadLetters clear:true];
+    }
+  }
+}
+
 #pragma mark - Property getters & setters
 
 /**
@@ -791,6 +955,108 @@ static NSString* const EventPlatform = @"platform";
   }
 }
 
+/**
+  Implements drainTimeout setter.
+*/
+- (void)setDrainTimeout:(int)aValue {
+  @synchronized(self.m_propertyLock) {
+    self->_drainTimeout = aValue;
+  }
+}
+
+/**
+  Implements drainTimeout getter.
+*/
+- (int)drainTimeout {
+  @synchronized(self.m_propertyLock) {
+    return self->_drainTimeout;
+  }
+}
+
+/**
+  Implements heartbeatInterval setter.
+*/
+- (void)setHeartbeatInterval:(int)aValue {
+  @synchronized(self.m_propertyLock) {
+    self->_heartbeatInterval = aValue;
+  }
+}
+
+/**
+  Implements heartbeatInterval getter.
+*/
+- (int)heartbeatInterval {
+  @synchronized(self.m_propertyLock) {
+    return self->_heartbeatInterval;
+  }
+}
+
+/**
+  Implements serverURL setter.
+*/
+- (void)setServerURL:(NSString*)aValue {
+  @synchronized(self.m_propertyLock) {
+    self->_serverURL = aValue;
+  }
+}
+
+/**
+  Implements serverURL getter.
+*/
+- (NSString*)serverURL {
+  @synchronized(self.m_propertyLock) {
+    return self->_serverURL;
+  }
+}
+
+/**
+  Implements wireFormat setter.
+*/
+- (void)setWireFormat:(IQUSDKWireFormat)aValue {
+  @synchronized(self.m_propertyLock) {
+    self->_wireFormat = aValue;
+  }
+}
+
+/**
+  Implements wireFormat getter.
+*/
+- (IQUSDKWireFormat)wireFormat {
+  @synchronized(self.m_propertyLock) {
+    return self->_wireFormat;
+  }
+}
+
+/**
+  Implements maxDeadLetterCount setter.
+*/
+- (void)setMaxDeadLetterCount:(int)aValue {
+  @synchronized(self.m_propertyLock) {
+    self->_maxDeadLetterCount = aValue;
+  }
+  // shrink the stored dead letters to the new maximum
+  IQUSDKMessageQueue* deadLetters = self.m_deadLetterMessages;
+  if (deadLetters != nil) {
+    @synchronized(deadLetters) {
+      if (aValue > 0) {
+        deadLetters.maxCount = aValue;
+        [deadLetters save];
+      } else {
+        [deadLetters clear:true];
+      }
+    }
+  }
+}
+
+/**
+  Implements maxDeadLetterCount getter.
+*/
+- (int)maxDeadLetterCount {
+  @synchronized(self.m_propertyLock) {
+    return self->_maxDeadLetterCount;
+  }
+}
+
 /**
   Implements logEnabled setter.
 */
@@ -878,6 +1144,8 @@ static NSString* const EventPlatform = @"platform";
   // create message queues
   self.m_pendingMessages = [[IQUSDKMessageQueue alloc] init];
   self.m_sendingMessages = [[IQUSDKMessageQueue alloc] init];
+  self.m_deadLetterMessages = [[IQUSDKMessageQueue alloc] init:DeadLetterFileName];
+  self.m_deadLetterMessages.maxCount = self.maxDeadLetterCount;
   // update properties
   self.payable = aPayable;
   // retrieve or create an unique ID
@@ -886,7 +1154,7 @@ static NSString* const EventPlatform = @"platform";
   [self obtainAdvertisingID];
   // start update thread
   [self startUpdateThread];
-#ifdef TARGET_OS_IPHONE
+#if TARGET_OS_IPHONE
   // handle application state changes within iOS
   [[NSNotificationCenter defaultCenter] addObserver:self
                                            selector:@selector(handleEnterBackground)
@@ -948,11 +1216,15 @@ static NSString* const EventPlatform = @"platform";
     [self.m_sendingMessages destroy];
     self.m_sendingMessages = nil;
   }
+  if (self.m_deadLetterMessages != nil) {
+    [self.m_deadLetterMessages destroy];
+    self.m_deadLetterMessages = nil;
+  }
   if (self.m_ids != nil) {
     [self.m_ids destroy];
     self.m_ids = nil;
   }
-#ifdef TARGET_OS_IPHONE
+#if TARGET_OS_IPHONE
   [[NSNotificationCenter defaultCenter] removeObserver:self
                                                   name:UIApplicationWillEnterForegroundNotification
                                                 object:nil];
@@ -1000,7 +1272,7 @@ static NSString* const EventPlatform = @"platform";
 */
 - (void)obtainAdvertisingID {
 #ifdef IQUSDK_ADVERTISING_ID
-#ifdef TARGET_OS_IPHONE
+#if TARGET_OS_IPHONE
   // get ASIdentifierManager class
   Class identifierManager = NSClassFromString(@"ASIdentifierManager");
   if (identifierManager != nil) {
@@ -1028,7 +1300,7 @@ static NSString* const EventPlatform = @"platform";
   Implements the obtainVendorID method.
 */
 - (void)obtainVendorID {
-#ifdef TARGET_OS_IPHONE
+#if TARGET_OS_IPHONE
   NSString* uuid;
   // use vendor uuid if it is available
   if ([[UIDevice currentDevice] respondsToSelector:NSSelectorFromString(@"identifierForVendor")]) {
@@ -1078,8 +1350,7 @@ static NSString* const EventPlatform = @"platform";
       }
     }
     // wait and repeat loop, using semaphore so the wait can be interrupted
-    int64_t updateInterval = (int64_t)(self.updateInterval) * (int64_t)(NSEC_PER_MSEC);
-    dispatch_semaphore_wait(self.m_updateSemaphore, dispatch_time(DISPATCH_TIME_NOW, updateInterval));
+    [IQUSDKUtils wait:self.m_updateSemaphore timeout:(int64_t)(self.updateInterval)];
   }
   // clear reference
   self.m_updateThread = nil;
@@ -1101,7 +1372,7 @@ static NSString* const EventPlatform = @"platform";
   if (self.m_updateThread != nil) {
     // first pause the thread
     if (!self.m_updateThreadPaused) {
-      [self pauseUpdateThread];
+      [self pauseUpdateThread:[IQUSDKUtils currentTimeMillis]];
     }
     // stop thread from running
     self.m_updateThreadRunning = false;
@@ -1117,23 +1388,37 @@ static NSString* const EventPlatform = @"platform";
 /**
   Implements the pauseUpdateThread method.
 */
-- (void)pauseUpdateThread {
+- (void)pauseUpdateThread:(int64_t)aDeadline {
   // prevent update from doing anything (when update call starts while
   // processing this code)
   self.m_updateThreadWait = true;
   @try {
     // thread is paused now
     self.m_updateThreadPaused = true;
-    // cancel any IO being executed
-    if (self.m_network != nil)
-      [self.m_network cancelSend];
   } @finally {
     // unblock update, if it was waiting it will exit immediately
     // because of paused state
     self.m_updateThreadWait = false;
   }
-  // wait for update thread to finish current update call
-  [self waitForUpdateThread];
+  // give the current update call (and any IO) time to finish
+  if (![self waitForUpdateThread:aDeadline]) {
+    // cancel any IO being executed
+    if (self.m_network != nil)
+      [self.m_network cancelSend];
+    // wait for update thread to finish current update call
+    [self waitForUpdateThread];
+  }
+}
+
+/**
+  Implements the drainUpdateThread method.
+*/
+- (void)drainUpdateThread {
+  int64_t deadline = [IQUSDKUtils currentTimeMillis] + (int64_t)(self.drainTimeout);
+  [self pauseUpdateThread:deadline];
+  if (self.initialized && (self.m_network != nil)) {
+    [self sendPriorityMessages:deadline];
+  }
 }
 
 /**
@@ -1152,6 +1437,16 @@ static NSString* const EventPlatform = @"platform";
   }
 }
 
+/**
+  Implements the waitForUpdateThread: method.
+*/
+- (bool)waitForUpdateThread:(int64_t)aDeadline {
+  while (self.m_updateThreadBusy && ([IQUSDKUtils currentTimeMillis] < aDeadline)) {
+    [IQUSDKUtils sleep:10];
+  }
+  return !self.m_updateThreadBusy;
+}
+
 #pragma mark - Private message related methods
 
 /**
@@ -1164,6 +1459,16 @@ static NSString* const EventPlatform = @"platform";
     [self.m_pendingMessages prepend:storedMessages changeQueue:true];
   }
   [storedMessages destroy];
+  // get messages rejected in previous sessions
+  @synchronized(self.m_deadLetterMessages) {
+    [self.m_deadLetterMessages load];
+    // remove rejected messages stored while a higher maximum was used
+    if (self.maxDeadLetterCount > 0) {
+      [self.m_deadLetterMessages save];
+    } else {
+      [self.m_deadLetterMessages clear:true];
+    }
+  }
 }
 
 /**
@@ -1183,8 +1488,9 @@ static NSString* const EventPlatform = @"platform";
   [self trackHeartbeat:self.m_sendingMessages];
   // any message that needs to be sent?
   if (![self.m_sendingMessages isEmpty]) {
-    // server is available?
-    if ([self checkServer]) {
+    // server is available and the thread did not get paused meanwhile? (when paused only a request that is already
+    // running may finish, a drain sends its own small batch)
+    if ([self checkServer] && !self.m_updateThreadPaused) {
       // try to send the messages
       [self sendMessages:self.m_sendingMessages];
     } else {
@@ -1208,9 +1514,21 @@ static NSString* const EventPlatform = @"platform";
 */
 - (void)sendMessages:(IQUSDKMessageQueue*)aMessages {
   // try to send messages to the server
-  if ([self.m_network send:aMessages]) {
-    // messages were sent successfully, so destroy them (including the persistent stored messages).
-    [aMessages clear:true];
+  NSArray* results = [self.m_network send:aMessages];
+  bool processed = false;
+  if (results != nil) {
+    @synchronized(self.m_deadLetterMessages) {
+      // destroy accepted messages (clearing the persistent stored messages when all were accepted) and move
+      // rejected messages to the dead letters (or destroy them if no dead letters should be kept).
+      processed = [aMessages processResults:results
+                                deadLetters:(self.maxDeadLetterCount > 0) ? self.m_deadLetterMessages : nil];
+      [self.m_deadLetterMessages save];
+    }
+  }
+  // server processed at least one message?
+  if (processed) {
+    // save messages the server could not process yet, they will be sent again
+    [aMessages save];
     // server is available
     self.serverAvailable = true;
   } else {
@@ -1224,6 +1542,40 @@ static NSString* const EventPlatform = @"platform";
   }
 }
 
+/**
+  Implements the sendPriorityMessages method.
+*/
+- (void)sendPriorityMessages:(int64_t)aDeadline {
+  int64_t timeLeft = aDeadline - [IQUSDKUtils currentTimeMillis];
+  // not enough time left or server was not reachable the last time?
+  if ((timeLeft < DrainMinSendTime) || !self.serverAvailable) {
+    return;
+  }
+  // take revenue messages first, fill up with the oldest other messages
+  IQUSDKMessageQueue* messages = [[IQUSDKMessageQueue alloc] init:DrainFileName];
+  @synchronized(self.m_pendingMessages) {
+    [self.m_pendingMessages moveTo:messages eventType:IQUSDKEventRevenue maxCount:DrainBatchSize];
+    [self.m_pendingMessages moveTo:messages eventType:nil maxCount:DrainBatchSize];
+  }
+  if ([messages isEmpty]) {
+    return;
+  }
+#ifdef IQUSDK_DEBUG
+  [self addLog:[NSString stringWithFormat:@"[SDK] sending %d messages before pausing", [messages getCount]]];
+#endif
+  NSArray* results = [self.m_network send:messages timeout:(int)timeLeft];
+  if (results != nil) {
+    @synchronized(self.m_deadLetterMessages) {
+      [messages processResults:results deadLetters:(self.maxDeadLetterCount > 0) ? self.m_deadLetterMessages : nil];
+    }
+  }
+  // return messages that were not sent to the front of the pending messages
+  @synchronized(self.m_pendingMessages) {
+    [self.m_pendingMessages prepend:messages changeQueue:true];
+  }
+  [messages destroy];
+}
+
 /**
   Implements the addMessage method.
 */
@@ -1239,6 +1591,21 @@ static NSString* const EventPlatform = @"platform";
 
 #pragma mark - Private event related methods
 
+/**
+  Implements the canTrack method.
+*/
+- (bool)canTrack:(NSString*)anEventType {
+  // exit if not enabled or not initialized yet
+  if (!self.analyticsEnabled || !self.initialized) {
+    return false;
+  }
+  NSString* sdkID;
+  @synchronized(self.m_ids) {
+    sdkID = [self.m_ids get:IQUSDKIDTypeSDK];
+  }
+  return [self.m_eventLimiter allow:anEventType sdkID:sdkID];
+}
+
 /**
   Implements the addEvent method.
 */
@@ -1258,7 +1625,8 @@ static NSString* const EventPlatform = @"platform";
   [result setObject:anEventType forKey:@"type"];
   NSDateFormatter* dateFormat = [[NSDateFormatter alloc] init];
   [dateFormat setDateFormat:@"yyyy'-'MM'-'dd' 'HH':'mm':'ss"];
-  [result setObject:[dateFormat stringFromDate:[NSDate date]] forKey:@"timestamp"];
+  NSDate* now = [NSDate dateWithTimeIntervalSince1970:((NSTimeInterval)[IQUSDKUtils currentTimeMillis]) / 1000];
+  [result setObject:[dateFormat stringFromDate:now] forKey:@"timestamp"];
   return result;
 }
 
@@ -1314,7 +1682,7 @@ static NSString* const EventPlatform = @"platform";
 */
 - (void)trackHeartbeat:(IQUSDKMessageQueue*)aMessages {
   int64_t currentTime = [IQUSDKUtils currentTimeMillis];
-  if (currentTime > self.m_heartbeatTime + HeartbeatInterval) {
+  if (currentTime > self.m_heartbeatTime + (int64_t)(self.heartbeatInterval)) {
     NSMutableDictionary* event = [self createEvent:EventHeartbeat];
     [event setObject:@(self.payable) forKey:@"is_payable"];
     @synchronized(self.m_ids) {
@@ -1331,7 +1699,7 @@ static NSString* const EventPlatform = @"platform";
   NSMutableDictionary* event = [self createEvent:EventPlatform];
   [event setObject:@"Apple" forKey:@"manufacturer"];
   [event setObject:@"Apple" forKey:@"device_brand"];
-#ifdef TARGET_OS_IPHONE
+#if TARGET_OS_IPHONE
   UIDevice* currentDevice = [UIDevice currentDevice];
   [event setObject:currentDevice.model forKey:@"device_model"];
   CTTelephonyNetworkInfo* myNetworkInfo = [[CTTelephonyNetworkInfo alloc] init];
@@ -1364,7 +1732,7 @@ static NSString* const EventPlatform = @"platform";
   Implements the onEnterBackground method.
 */
 - (void)handleEnterBackground {
-  [self pauseUpdateThread];
+  [self drainUpdateThread];
   if (self.m_localStorage != nil) {
     [self.m_localStorage save];
   }
@@ -1373,6 +1741,11 @@ static NSString* const EventPlatform = @"platform";
       [self.m_pendingMessages save];
     }
   }
+  if (self.m_deadLetterMessages != nil) {
+    @synchronized(self.m_deadLetterMessages) {
+      [self.m_deadLetterMessages save];
+    }
+  }
 #ifdef IQUSDK_DEBUG
   [self addLog:@"[SDK] enter background"];
 #endif
@@ -1392,12 +1765,21 @@ static NSString* const EventPlatform = @"platform";
   Implements the onTerminate method.
 */
 - (void)handleTerminate {
+  // finish sending (if the application was not in the background) and stop the update thread
+  if (!self.m_updateThreadPaused) {
+    [self drainUpdateThread];
+  }
   [self destroyUpdateThread];
   if (self.m_pendingMessages != nil) {
     @synchronized(self.m_pendingMessages) {
       [self.m_pendingMessages save];
     }
   }
+  if (self.m_deadLetterMessages != nil) {
+    @synchronized(self.m_deadLetterMessages) {
+      [self.m_deadLetterMessages save];
+    }
+  }
   [self clearReferences];
 }
 
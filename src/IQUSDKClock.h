@@ -0,0 +1,36 @@
+#import <Foundation/Foundation.h>
+#import <dispatch/dispatch.h>
+
+#pragma mark - INTERFACE
+
+/**
+  IQUSDKClock defines the time source used by the IQU SDK. All time related actions (getting the current time, 
+  sleeping and waiting) are performed via the active clock, see [IQUSDKUtils setClock:].
+*/
+@protocol IQUSDKClock<NSObject>
+
+/**
+  Returns the time passed in milliseconds since 1970-01-01 00:00:00.000
+ 
+  @return time in milliseconds
+*/
+- (int64_t)currentTimeMillis;
+
+/**
+  Blocks the calling thread for a certain time.
+ 
+  @param aMilliseconds Time to sleep in milliseconds.
+*/
+- (void)sleep:(int64_t)aMilliseconds;
+
+/**
+  Waits for a semaphore to get signalled or until a time-out has occurred.
+ 
+  @param aSemaphore Semaphore to wait for.
+  @param aMilliseconds Maximum time to wait in milliseconds.
+ 
+  @return <code>true</code> if the semaphore got signalled, <code>false</code> if a time-out occurred.
+*/
+- (bool)wait:(dispatch_semaphore_t)aSemaphore timeout:(int64_t)aMilliseconds;
+
+@end
@@ -0,0 +1,11 @@
+#import <Foundation/Foundation.h>
+#import "IQUSDKHMAC.h"
+
+#pragma mark - INTERFACE
+
+/**
+  IQUSDKCommonCryptoHMAC implements IQUSDKHMAC using CommonCrypto. Only available when IQUSDK_COMMONCRYPTO is defined.
+*/
+@interface IQUSDKCommonCryptoHMAC : NSObject<IQUSDKHMAC>
+
+@end
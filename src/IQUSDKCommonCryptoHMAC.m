@@ -0,0 +1,31 @@
+#import "IQUSDKConfig.h"
+#ifdef IQUSDK_COMMONCRYPTO
+#import <CommonCrypto/CommonDigest.h>
+#import <CommonCrypto/CommonHMAC.h>
+#import "IQUSDKCommonCryptoHMAC.h"
+#import "IQUSDKUtils.h"
+
+#pragma mark - PRIVATE DEFINITIONS
+
+@interface IQUSDKCommonCryptoHMAC ()
+@end
+
+#pragma mark - IMPLEMENTATION
+
+@implementation IQUSDKCommonCryptoHMAC
+
+#pragma mark - IQUSDKHMAC
+
+/**
+  Implements the sha512 method.
+*/
+- (NSString*)sha512:(NSString*)aText withKey:(NSString*)aKey {
+  const char* key = [aKey cStringUsingEncoding:NSUTF8StringEncoding];
+  const char* data = [aText cStringUsingEncoding:NSUTF8StringEncoding];
+  unsigned char digest[CC_SHA512_DIGEST_LENGTH];
+  CCHmac(kCCHmacAlgSHA512, key, strlen(key), data, strlen(data), digest);
+  return [IQUSDKUtils toHex:digest length:CC_SHA512_DIGEST_LENGTH];
+}
+
+@end
+#endif
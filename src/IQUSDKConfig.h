@@ -14,6 +14,20 @@
 */
 #define IQUSDK_ADVERTISING_ID
 
+/**
+  Backends used for network IO and for signing messages.
+ 
+  Apple platforms use NSURLConnection (IQUSDK_URLCONNECTION) and CommonCrypto (IQUSDK_COMMONCRYPTO); other platforms 
+  (GNUstep on Linux) use libcurl (IQUSDK_CURL) and OpenSSL (IQUSDK_OPENSSL).
+*/
+#ifdef __APPLE__
+#define IQUSDK_URLCONNECTION
+#define IQUSDK_COMMONCRYPTO
+#else
+#define IQUSDK_CURL
+#define IQUSDK_OPENSSL
+#endif
+
 /**
   Version of the SDK
 */
@@ -0,0 +1,12 @@
+#import <Foundation/Foundation.h>
+#import "IQUSDKTransport.h"
+
+#pragma mark - INTERFACE
+
+/**
+  IQUSDKCurlTransport implements IQUSDKTransport using libcurl. The same curl handle is used for every request, so
+  connections to the server are kept alive and reused. Only available when IQUSDK_CURL is defined.
+*/
+@interface IQUSDKCurlTransport : NSObject<IQUSDKTransport>
+
+@end
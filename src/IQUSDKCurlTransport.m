@@ -0,0 +1,162 @@
+#import "IQUSDKConfig.h"
+#ifdef IQUSDK_CURL
+#import <curl/curl.h>
+#import <dispatch/dispatch.h>
+#import "IQUSDKCurlTransport.h"
+#import "IQUSDK.h"
+
+#pragma mark - PRIVATE DEFINITIONS
+
+@interface IQUSDKCurlTransport ()
+
+#pragma mark - Private properties
+
+/**
+  When true cancel any active IO running.
+*/
+@property bool m_cancel;
+
+/**
+  Curl handle, reused for every request. NULL until the first request.
+*/
+@property CURL* m_curl;
+
+@end
+
+#pragma mark - Curl callbacks
+
+/**
+  Called by curl with data received from the server, the data is appended to the NSMutableData instance passed via
+  CURLOPT_WRITEDATA.
+*/
+static size_t writeCallback(char* aData, size_t aSize, size_t aCount, void* aUserData) {
+  NSMutableData* responseData = (__bridge NSMutableData*)aUserData;
+  [responseData appendBytes:aData length:aSize * aCount];
+  return aSize * aCount;
+}
+
+/**
+  Called by curl while IO is busy, returning a non zero value aborts the IO. The IQUSDKCurlTransport instance is
+  passed via CURLOPT_XFERINFODATA.
+*/
+static int progressCallback(void* aUserData, curl_off_t aDownloadTotal, curl_off_t aDownloadNow,
+                            curl_off_t anUploadTotal, curl_off_t anUploadNow) {
+  IQUSDKCurlTransport* transport = (__bridge IQUSDKCurlTransport*)aUserData;
+  return transport.m_cancel ? 1 : 0;
+}
+
+#pragma mark - IMPLEMENTATION
+
+@implementation IQUSDKCurlTransport
+
+#pragma mark - Initializers
+
+/**
+  Initializes the instance.
+*/
+- (instancetype)init {
+  self = [super init];
+  if (self != nil) {
+    static dispatch_once_t curlInitialized;
+    dispatch_once(&curlInitialized, ^{
+      curl_global_init(CURL_GLOBAL_DEFAULT);
+    });
+    self.m_cancel = false;
+    self.m_curl = NULL;
+  }
+  return self;
+}
+
+#pragma mark - IQUSDKTransport
+
+/**
+  Implements the send method.
+*/
+- (NSDictionary*)send:(NSString*)anURL postContent:(NSString*)aPostContent timeout:(int)aTimeout {
+  NSMutableDictionary* result = [[NSMutableDictionary alloc] initWithCapacity:2];
+  // create handle the first time, else reset the options of the previous request (keeping the connections alive)
+  if (self.m_curl == NULL) {
+    self.m_curl = curl_easy_init();
+  } else {
+    curl_easy_reset(self.m_curl);
+  }
+  CURL* curl = self.m_curl;
+  if (curl == NULL) {
+    [result setObject:@"error: curl handle could not be created." forKey:IQUSDKTransportErrorKey];
+    return result;
+  }
+  NSMutableData* responseData = [[NSMutableData alloc] init];
+  // set SDK version and type in header
+  struct curl_slist* headers = NULL;
+  headers = curl_slist_append(headers, "SdkVersion: " IQUSDK_VERSION);
+  headers = curl_slist_append(headers, "SdkType: " IQUSDK_TYPE);
+  // initialize request without or with POST content
+  NSData* body = nil;
+  if (aPostContent == nil) {
+    curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+  } else {
+    body = [aPostContent dataUsingEncoding:NSUTF8StringEncoding];
+    headers = curl_slist_append(headers, "Content-Type: application/json");
+    curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.bytes);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, (curl_off_t)body.length);
+  }
+  curl_easy_setopt(curl, CURLOPT_URL, [anURL UTF8String]);
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+  curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, (long)aTimeout);
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, (__bridge void*)responseData);
+  curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+  curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, progressCallback);
+  curl_easy_setopt(curl, CURLOPT_XFERINFODATA, (__bridge void*)self);
+  // perform IO and wait for it to finish
+  CURLcode code = curl_easy_perform(curl);
+  curl_slist_free_all(headers);
+  // add status code from http response (if any)
+  long statusCode = 0;
+  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
+  if (statusCode > 0) {
+    [result setObject:@(statusCode) forKey:IQUSDKTransportCodeKey];
+#ifdef IQUSDK_DEBUG
+    [[IQUSDK instance] addLog:[NSString stringWithFormat:@"[Network][Response] code = %ld", statusCode]];
+#endif
+  }
+  // cancelled?
+  if (self.m_cancel) {
+    [result setObject:@"error: io was cancelled." forKey:IQUSDKTransportErrorKey];
+  }
+  // not finished?
+  else if (code == CURLE_OPERATION_TIMEDOUT) {
+    [result setObject:@"error: io did not finish in time (timeout error)." forKey:IQUSDKTransportErrorKey];
+  } else if (code != CURLE_OK) {
+    [result setObject:[NSString stringWithUTF8String:curl_easy_strerror(code)] forKey:IQUSDKTransportErrorKey];
+  } else {
+    [result setObject:responseData forKey:IQUSDKTransportDataKey];
+  }
+  // reset cancel for next time
+  self.m_cancel = false;
+  return result;
+}
+
+/**
+  Implements the cancel method.
+*/
+- (void)cancel {
+  self.m_cancel = true;
+}
+
+/**
+  Implements the destroy method.
+*/
+- (void)destroy {
+  // stop any io
+  self.m_cancel = true;
+  if (self.m_curl != NULL) {
+    curl_easy_cleanup(self.m_curl);
+    self.m_curl = NULL;
+  }
+}
+
+@end
+#endif
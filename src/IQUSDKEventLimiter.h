@@ -0,0 +1,63 @@
+#import <Foundation/Foundation.h>
+
+#pragma mark - INTERFACE
+
+/**
+  IQUSDKEventLimiter decides per event type if an event may be tracked. It supports a token bucket rate limit and
+  deterministic sampling per event type and counts the number of suppressed events.
+ 
+  Protected event types are never suppressed.
+ 
+  All methods are thread safe.
+*/
+@interface IQUSDKEventLimiter : NSObject
+
+#pragma mark - Public methods
+
+/**
+  Sets the rate limit for an event type. Events are allowed as long as there are tokens in the bucket; the bucket is
+  refilled with aRate tokens per second up to aBurst tokens. The bucket starts full.
+ 
+  @param anEventType Event type to set limit for
+  @param aRate Number of events per second allowed on average, use 0 or less to remove the limit.
+  @param aBurst Maximum number of events allowed in a burst (minimum 1).
+*/
+- (void)setRateLimit:(NSString*)anEventType rate:(double)aRate burst:(int)aBurst;
+
+/**
+  Sets the sample rate for an event type. The decision is based on the SDK ID and the event type, so a user either
+  tracks all or none of the events of that type.
+ 
+  @param anEventType Event type to set the sample rate for
+  @param aRate Fraction of users that track the event type (0.0 - 1.0), use 1.0 to track all.
+*/
+- (void)setSampleRate:(NSString*)anEventType rate:(double)aRate;
+
+/**
+  Protects an event type, events of that type are never suppressed.
+ 
+  @param anEventType Event type to protect.
+*/
+- (void)protect:(NSString*)anEventType;
+
+/**
+  Checks if an event may be tracked. When the event is not allowed, the suppressed count for the event type is
+  increased.
+ 
+  @param anEventType Type of the event
+  @param anID SDK ID to base the sampling decision on
+ 
+  @return <code>true</code> if the event may be tracked, <code>false</code> if it should be suppressed.
+*/
+- (bool)allow:(NSString*)anEventType sdkID:(NSString*)anID;
+
+/**
+  Gets the number of suppressed events for an event type.
+ 
+  @param anEventType Event type to get count for
+ 
+  @return number of suppressed events.
+*/
+- (int64_t)getSuppressedCount:(NSString*)anEventType;
+
+@end
@@ -0,0 +1,245 @@
+#import "IQUSDKConfig.h"
+#import "IQUSDKEventLimiter.h"
+#import "IQUSDKUtils.h"
+
+#pragma mark - PRIVATE DEFINITIONS
+
+/**
+  IQUSDKEventTypeLimit contains the settings and state for a single event type.
+*/
+@interface IQUSDKEventTypeLimit : NSObject
+
+/**
+  Tokens added per millisecond, 0 if there is no rate limit.
+*/
+@property double rate;
+
+/**
+  Maximum number of tokens.
+*/
+@property double burst;
+
+/**
+  Current number of tokens.
+*/
+@property double tokens;
+
+/**
+  Time the tokens were last updated.
+*/
+@property int64_t tokenTime;
+
+/**
+  Fraction of users that track this event type.
+*/
+@property double sampleRate;
+
+/**
+  SDK ID the sampled value was determined for.
+*/
+@property NSString* sampleID;
+
+/**
+  Cached sampling decision for sampleID.
+*/
+@property bool sampled;
+
+/**
+  Number of suppressed events.
+*/
+@property int64_t suppressedCount;
+
+@end
+
+@implementation IQUSDKEventTypeLimit
+@end
+
+@interface IQUSDKEventLimiter ()
+
+#pragma mark - Private properties
+
+/**
+  Limits per event type.
+*/
+@property NSMutableDictionary* m_limits;
+
+/**
+  Event types that are never suppressed.
+*/
+@property NSMutableSet* m_protected;
+
+#pragma mark - Private methods
+
+/**
+  Gets the limit for an event type, creating it if it does not exist yet.
+ 
+  @param anEventType Event type to get limit for
+ 
+  @return IQUSDKEventTypeLimit instance
+*/
+- (IQUSDKEventTypeLimit*)getLimit:(NSString*)anEventType;
+
+/**
+  Determines if a SDK ID is part of the sample for an event type.
+ 
+  @param anID SDK ID
+  @param anEventType Event type
+  @param aRate Sample rate
+ 
+  @return <code>true</code> if the events should be tracked.
+*/
+- (bool)isSampled:(NSString*)anID eventType:(NSString*)anEventType rate:(double)aRate;
+
+@end
+
+#pragma mark - IMPLEMENTATION
+
+@implementation IQUSDKEventLimiter
+
+#pragma mark - Private consts
+
+/**
+  Number of buckets used for sampling.
+*/
+static const uint64_t SampleBuckets = 10000;
+
+#pragma mark - Initializers
+
+/**
+  Initializes the instance.
+*/
+- (instancetype)init {
+  self = [super init];
+  if (self != nil) {
+    self.m_limits = [[NSMutableDictionary alloc] init];
+    self.m_protected = [[NSMutableSet alloc] init];
+  }
+  return self;
+}
+
+#pragma mark - Public methods
+
+/**
+  Implements the setRateLimit method.
+*/
+- (void)setRateLimit:(NSString*)anEventType rate:(double)aRate burst:(int)aBurst {
+  @synchronized(self) {
+    IQUSDKEventTypeLimit* limit = [self getLimit:anEventType];
+    limit.rate = (aRate > 0) ? aRate / 1000 : 0;
+    limit.burst = (aBurst < 1) ? 1 : aBurst;
+    limit.tokens = limit.burst;
+    limit.tokenTime = [IQUSDKUtils currentTimeMillis];
+  }
+}
+
+/**
+  Implements the setSampleRate method.
+*/
+- (void)setSampleRate:(NSString*)anEventType rate:(double)aRate {
+  @synchronized(self) {
+    IQUSDKEventTypeLimit* limit = [self getLimit:anEventType];
+    limit.sampleRate = aRate;
+    limit.sampleID = nil;
+  }
+}
+
+/**
+  Implements the protect method.
+*/
+- (void)protect:(NSString*)anEventType {
+  @synchronized(self) {
+    [self.m_protected addObject:anEventType];
+  }
+}
+
+/**
+  Implements the allow method.
+*/
+- (bool)allow:(NSString*)anEventType sdkID:(NSString*)anID {
+  @synchronized(self) {
+    if ([self.m_protected containsObject:anEventType]) {
+      return true;
+    }
+    IQUSDKEventTypeLimit* limit = [self.m_limits objectForKey:anEventType];
+    // no limits for this type?
+    if (limit == nil) {
+      return true;
+    }
+    // determine sample decision once per SDK ID
+    if ((limit.sampleID == nil) || ![limit.sampleID isEqualToString:anID]) {
+      limit.sampleID = anID;
+      limit.sampled = [self isSampled:anID eventType:anEventType rate:limit.sampleRate];
+    }
+    if (!limit.sampled) {
+      limit.suppressedCount++;
+      return false;
+    }
+    // token bucket
+    if (limit.rate > 0) {
+      int64_t currentTime = [IQUSDKUtils currentTimeMillis];
+      // ignore time running backwards (the system clock might be adjusted)
+      int64_t elapsed = MAX((int64_t)0, currentTime - limit.tokenTime);
+      limit.tokens = MAX(0.0, MIN(limit.burst, limit.tokens + elapsed * limit.rate));
+      limit.tokenTime = currentTime;
+      if (limit.tokens < 1) {
+        limit.suppressedCount++;
+        return false;
+      }
+      limit.tokens -= 1;
+    }
+    return true;
+  }
+}
+
+/**
+  Implements the getSuppressedCount method.
+*/
+- (int64_t)getSuppressedCount:(NSString*)anEventType {
+  @synchronized(self) {
+    IQUSDKEventTypeLimit* limit = [self.m_limits objectForKey:anEventType];
+    return limit == nil ? 0 : limit.suppressedCount;
+  }
+}
+
+#pragma mark - Private methods
+
+/**
+  Implements the getLimit method.
+*/
+- (IQUSDKEventTypeLimit*)getLimit:(NSString*)anEventType {
+  IQUSDKEventTypeLimit* limit = [self.m_limits objectForKey:anEventType];
+  if (limit == nil) {
+    limit = [[IQUSDKEventTypeLimit alloc] init];
+    limit.rate = 0;
+    limit.burst = 1;
+    limit.tokens = 1;
+    limit.tokenTime = 0;
+    limit.sampleRate = 1.0;
+    limit.sampleID = nil;
+    limit.sampled = true;
+    limit.suppressedCount = 0;
+    [self.m_limits setObject:limit forKey:anEventType];
+  }
+  return limit;
+}
+
+/**
+  Implements the isSampled method. Uses a FNV-1a hash so the result is the same on every platform and run.
+*/
+- (bool)isSampled:(NSString*)anID eventType:(NSString*)anEventType rate:(double)aRate {
+  if (aRate >= 1.0) {
+    return true;
+  }
+  if (aRate <= 0.0) {
+    return false;
+  }
+  const char* text = [[NSString stringWithFormat:@"%@/%@", anID, anEventType] UTF8String];
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char* c = text; *c != 0; c++) {
+    hash ^= (uint8_t)*c;
+    hash *= 1099511628211ULL;
+  }
+  return (double)(hash % SampleBuckets) < aRate * (double)SampleBuckets;
+}
+
+@end
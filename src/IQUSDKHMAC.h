@@ -0,0 +1,20 @@
+#import <Foundation/Foundation.h>
+
+#pragma mark - INTERFACE
+
+/**
+  IQUSDKHMAC defines the backend used by IQUSDKNetwork to sign the messages.
+*/
+@protocol IQUSDKHMAC<NSObject>
+
+/**
+  Generates a SHA512 HMAC and returns the hash as a hex string.
+
+  @param aText Text to generate hash for
+  @param aKey  Key to use to generate hash
+
+  @return hash as lowercase hex string
+*/
+- (NSString*)sha512:(NSString*)aText withKey:(NSString*)aKey;
+
+@end
@@ -44,3 +44,8 @@ typedef NS_ENUM(NSInteger, IQUSDKIDType) {
   */
   IQUSDKIDTypeIOSAdTracking = 7
 };
+
+/**
+  Number of IQUSDKIDType values; update it when adding a type.
+*/
+enum { IQUSDKIDTypeCount = 8 };
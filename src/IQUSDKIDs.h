@@ -3,6 +3,9 @@
 
 #pragma mark - INTERFACE
 
+/**
+  IQUSDKIDs stores a value for every IQUSDKIDType in a fixed array indexed by the type.
+*/
 @interface IQUSDKIDs : NSObject<NSCoding>
 
 #pragma mark - Public methods
@@ -30,7 +33,7 @@
 - (NSString*)get:(IQUSDKIDType)aType;
 
 /**
-  Store a value for a certain type. Any previous value is overwritten.
+  Store a value for a certain type. Any previous value is overwritten. Storing an empty string removes the value.
  
   @param aType Type to store value for.
   @param aValue Value to store for the type.
@@ -51,6 +54,22 @@
 */
 - (IQUSDKIDs*)clone;
 
+/**
+  Checks if another instance contains the same ids.
+ 
+  @param anObject Object to compare with
+ 
+  @return <code>true</code> if anObject is an IQUSDKIDs instance with the same ids.
+*/
+- (BOOL)isEqual:(id)anObject;
+
+/**
+  Returns a hash value based on the stored ids.
+ 
+  @return hash value
+*/
+- (NSUInteger)hash;
+
 /**
   Returns ids as JSON formatted string; only non empty ids are returned.
  
@@ -4,14 +4,12 @@
 
 #pragma mark - PRIVATE DEFINITIONS
 
-@interface IQUSDKIDs ()
-
-#pragma mark - Private properties
-
-/**
-  Storage space for key & value pairs.
-*/
-@property NSMutableDictionary* m_ids;
+@interface IQUSDKIDs () {
+  /**
+    Storage space for the values, indexed by IQUSDKIDType. Empty values are stored as nil.
+  */
+  NSString* m_values[IQUSDKIDTypeCount];
+}
 
 #pragma mark - Private methods
 
@@ -32,18 +30,6 @@
 
 #pragma mark - Private consts
 
-/**
-  Define an array with all types (since objective c can not enumerate over enum types)
-*/
-static IQUSDKIDType const m_types[] = {IQUSDKIDTypeCustom,
-                                       IQUSDKIDTypeFacebook,
-                                       IQUSDKIDTypeGooglePlus,
-                                       IQUSDKIDTypeIOSAdvertising,
-                                       IQUSDKIDTypeIOSAdTracking,
-                                       IQUSDKIDTypeIOSVendor,
-                                       IQUSDKIDTypeSDK,
-                                       IQUSDKIDTypeTwitter};
-
 /**
   Key used with NSCoder.
 */
@@ -56,19 +42,19 @@ static NSString* const IDsKey = @"IDs";
 */
 - (instancetype)init {
   self = [super init];
-  if (self != nil) {
-    self.m_ids = [[NSMutableDictionary alloc] init];
-  }
   return self;
 }
 
 /**
-  Implements the initWithCoder method.
+  Implements the initWithCoder method. The ids are stored as a dictionary using the type as key.
 */
 - (instancetype)initWithCoder:(NSCoder*)aCoder {
   self = [super init];
   if (self != nil) {
-    self.m_ids = [aCoder decodeObjectForKey:IDsKey];
+    NSDictionary* ids = [aCoder decodeObjectForKey:IDsKey];
+    for (NSNumber* type in ids) {
+      [self set:type.integerValue value:[ids objectForKey:type]];
+    }
   }
   return self;
 }
@@ -81,7 +67,9 @@ static NSString* const IDsKey = @"IDs";
 - (instancetype)init:(IQUSDKIDs*)anIDs {
   self = [super init];
   if (self != nil) {
-    self.m_ids = anIDs.m_ids.mutableCopy;
+    for (int type = 0; type < IQUSDKIDTypeCount; type++) {
+      self->m_values[type] = anIDs->m_values[type];
+    }
   }
   return self;
 }
@@ -92,26 +80,29 @@ static NSString* const IDsKey = @"IDs";
   Implements the destroy method.
 */
 - (void)destroy {
-  self.m_ids = nil;
+  for (int type = 0; type < IQUSDKIDTypeCount; type++) {
+    self->m_values[type] = nil;
+  }
 }
 
 /**
   Implements encodeWithCoder method.
 */
 - (void)encodeWithCoder:(NSCoder*)aCoder {
-  [aCoder encodeObject:self.m_ids forKey:IDsKey];
+  NSMutableDictionary* ids = [[NSMutableDictionary alloc] initWithCapacity:IQUSDKIDTypeCount];
+  for (int type = 0; type < IQUSDKIDTypeCount; type++) {
+    if (self->m_values[type] != nil) {
+      [ids setObject:self->m_values[type] forKey:@(type)];
+    }
+  }
+  [aCoder encodeObject:ids forKey:IDsKey];
 }
 
 /**
   Implements the get method.
 */
 - (NSString*)get:(IQUSDKIDType)aType {
-  NSString* result = nil;
-  switch (aType) {
-    default:
-      result = [self.m_ids objectForKey:@(aType)];
-      break;
-  }
+  NSString* result = ((aType >= 0) && (aType < IQUSDKIDTypeCount)) ? self->m_values[aType] : nil;
   return result == nil ? @"" : result;
 }
 
@@ -119,7 +110,11 @@ static NSString* const IDsKey = @"IDs";
   Implements the set method.
 */
 - (void)set:(IQUSDKIDType)aType value:(NSString*)aValue {
-  [self.m_ids setObject:aValue forKey:@(aType)];
+  if ((aType < 0) || (aType >= IQUSDKIDTypeCount)) {
+    return;
+  }
+  // don't store empty values, so instances with the same non empty ids are equal
+  self->m_values[aType] = (aValue.length == 0) ? nil : [aValue copy];
 }
 
 /**
@@ -129,18 +124,48 @@ static NSString* const IDsKey = @"IDs";
   return [[IQUSDKIDs alloc] init:self];
 }
 
+/**
+  Implements the isEqual method.
+*/
+- (BOOL)isEqual:(id)anObject {
+  if (anObject == self) {
+    return YES;
+  }
+  if (![anObject isKindOfClass:[IQUSDKIDs class]]) {
+    return NO;
+  }
+  IQUSDKIDs* other = (IQUSDKIDs*)anObject;
+  for (int type = 0; type < IQUSDKIDTypeCount; type++) {
+    NSString* value = self->m_values[type];
+    NSString* otherValue = other->m_values[type];
+    if ((value != otherValue) && ![value isEqualToString:otherValue]) {
+      return NO;
+    }
+  }
+  return YES;
+}
+
+/**
+  Implements the hash method.
+*/
+- (NSUInteger)hash {
+  NSUInteger result = 0;
+  for (int type = 0; type < IQUSDKIDTypeCount; type++) {
+    result = result * 31 + [self->m_values[type] hash];
+  }
+  return result;
+}
+
 /**
   Implements the toJSONString method.
 */
 - (NSString*)toJSONString {
   // build a collection for non empty ids using JSON name of the type for key
   // and the id value as value.
-  NSMutableDictionary* collection = [[NSMutableDictionary alloc] initWithCapacity:self.m_ids.count];
-  for (int index = (sizeof m_types) / (sizeof m_types[0]) - 1; index >= 0; index--) {
-    IQUSDKIDType type = m_types[index];
-    NSString* value = [self get:type];
-    if (value.length > 0) {
-      [collection setObject:value forKey:[self getJSONName:type]];
+  NSMutableDictionary* collection = [[NSMutableDictionary alloc] initWithCapacity:IQUSDKIDTypeCount];
+  for (int type = 0; type < IQUSDKIDTypeCount; type++) {
+    if (self->m_values[type] != nil) {
+      [collection setObject:self->m_values[type] forKey:[self getJSONName:type]];
     }
   }
   return [IQUSDKUtils toJSON:collection];
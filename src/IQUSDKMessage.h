@@ -10,6 +10,9 @@
 
 /**
   IQUSDKMessage encapsulates a single message for the server. A message exists of an event and ids.
+ 
+  To keep large queues small, the event is stored as UTF-8 encoded JSON data and messages with the same event type
+  share the same event type string.
 */
 @interface IQUSDKMessage : NSObject<NSCoding>
 
@@ -36,11 +39,20 @@
 /**
   Initializes a new message instance and set the ids and event.
  
-  @param anIds Ids to use (a copy is stored)
+  @param anIds Ids to use (a shared instance containing the same ids is stored)
   @param anEvent Event the message encapsulates
 */
 - (instancetype)init:(IQUSDKIDs*)anIDs event:(id)anEvent;
 
+/**
+  Initializes a new message instance from an already JSON encoded event.
+ 
+  @param anIDs Ids to use (a shared instance containing the same ids is stored)
+  @param anEventData Event as UTF-8 encoded JSON data
+  @param anEventType Type of the event
+*/
+- (instancetype)init:(IQUSDKIDs*)anIDs eventData:(NSData*)anEventData eventType:(NSString*)anEventType;
+
 /**
   Removes references and resources.
 */
@@ -55,6 +67,31 @@
 */
 - (void)updateID:(IQUSDKIDType)aType newValue:(NSString*)aNewValue;
 
+/**
+  Gets the ids of the message.
+ 
+  @return IQUSDKIDs instance (not a copy); the instance is shared with other messages and must not be changed.
+*/
+- (IQUSDKIDs*)getIDs;
+
+/**
+  Gets the event as UTF-8 encoded JSON data.
+ 
+  @return NSData instance
+*/
+- (NSData*)getEventData;
+
+/**
+  Returns the event as JSON formatted string, referring to the ids by index using the following format:
+ 
+      { "identifiers":index, "event":{..} }
+ 
+  @param anIdentifiersIndex Index of the ids within the message batch.
+ 
+  @return JSON formatted object definition string
+*/
+- (NSString*)toJSONString:(int)anIdentifiersIndex;
+
 /**
   Returns the ids and event as JSON formatted string, using the following
   format:
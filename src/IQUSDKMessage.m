@@ -9,15 +9,43 @@
 #pragma mark - Private properties
 
 /**
-  The event (as JSON string)
+  The event (as UTF-8 encoded JSON data)
 */
-@property NSString* m_event;
+@property NSData* m_eventData;
 
 /**
   The ids.
 */
 @property IQUSDKIDs* m_ids;
 
+#pragma mark - Private methods
+
+/**
+  Returns a shared instance for an event type, so messages with the same event type share the same string.
+ 
+  @param anEventType Event type to get shared instance for
+ 
+  @return shared NSString instance or nil if anEventType is nil.
+*/
++ (NSString*)internEventType:(NSString*)anEventType;
+
+/**
+  Returns a shared instance for a set of ids, so messages with the same ids share the same IQUSDKIDs instance. The
+  shared instances are never changed, see updateID:newValue:.
+ 
+  @param anIDs Ids to get shared instance for
+ 
+  @return shared IQUSDKIDs instance or nil if anIDs is nil.
+*/
++ (IQUSDKIDs*)internIDs:(IQUSDKIDs*)anIDs;
+
+/**
+  Gets the event as JSON formatted string.
+ 
+  @return JSON formatted string
+*/
+- (NSString*)getEventString;
+
 @end
 
 #pragma mark - IMPLEMENTATION
@@ -41,6 +69,18 @@ static NSString* const EventTypeKey = @"EventType";
 */
 static NSString* const IdsKey = @"IDs";
 
+#pragma mark - Private static variables
+
+/**
+  Contains the shared event type instances.
+*/
+static NSMutableSet* m_eventTypes = nil;
+
+/**
+  Contains the shared ids instances. A new instance is only added when an id changes, so the set stays small.
+*/
+static NSMutableSet* m_sharedIDs = nil;
+
 #pragma mark - Initializers
 
 /**
@@ -50,12 +90,25 @@ static NSString* const IdsKey = @"IDs";
   self = [super init];
   if (self != nil) {
     NSError* error;
-    NSData* jsonData = [NSJSONSerialization dataWithJSONObject:anEvent
+    self.m_eventData = [NSJSONSerialization dataWithJSONObject:anEvent
                                                        options:0 error:&error];
-    self.m_event = [[NSString alloc] initWithData:jsonData
-                                         encoding:NSUTF8StringEncoding];
-    self.m_ids = [anIDs clone];
-    self->_eventType = [anEvent objectForKey:@"type"];
+    self.m_ids = [IQUSDKMessage internIDs:anIDs];
+    self->_eventType = [IQUSDKMessage internEventType:[anEvent objectForKey:@"type"]];
+    self->_next = nil;
+    self->_queue = nil;
+  }
+  return self;
+}
+
+/**
+  Implements the init:eventData:eventType method.
+*/
+- (instancetype)init:(IQUSDKIDs*)anIDs eventData:(NSData*)anEventData eventType:(NSString*)anEventType {
+  self = [super init];
+  if (self != nil) {
+    self.m_eventData = [anEventData copy];
+    self.m_ids = [IQUSDKMessage internIDs:anIDs];
+    self->_eventType = [IQUSDKMessage internEventType:anEventType];
     self->_next = nil;
     self->_queue = nil;
   }
@@ -70,10 +123,8 @@ static NSString* const IdsKey = @"IDs";
 - (void)destroy {
   self->_next = nil;
   self->_queue = nil;
-  if (self.m_ids != nil) {
-    [self.m_ids destroy];
-    self.m_ids = nil;
-  }
+  // the ids are shared with other messages, so only remove the reference
+  self.m_ids = nil;
 }
 
 /**
@@ -93,17 +144,90 @@ static NSString* const IdsKey = @"IDs";
       break;
   }
   if (![currentValue isEqualToString:aNewValue]) {
-    [self.m_ids set:aType value:aNewValue];
+    // the ids are shared with other messages, so change a copy
+    IQUSDKIDs* ids = [self.m_ids clone];
+    [ids set:aType value:aNewValue];
+    self.m_ids = [IQUSDKMessage internIDs:ids];
     [self.queue onMessageChanged:self];
   }
-  
+}
+
+/**
+  Implements the getIDs method.
+*/
+- (IQUSDKIDs*)getIDs {
+  return self.m_ids;
+}
+
+/**
+  Implements the getEventData method.
+*/
+- (NSData*)getEventData {
+  return self.m_eventData;
+}
+
+/**
+  Implements the toJSONString: method.
+*/
+- (NSString*)toJSONString:(int)anIdentifiersIndex {
+  return [NSString stringWithFormat:@"{\"identifiers\":%d,\"event\":%@}", anIdentifiersIndex, [self getEventString]];
 }
 
 /**
   Implements the toJSONString method.
 */
 - (NSString*)toJSONString {
-  return [NSString stringWithFormat:@"{\"identifiers\":%@,\"event\":%@}", [self.m_ids toJSONString], self.m_event];
+  return [NSString stringWithFormat:@"{\"identifiers\":%@,\"event\":%@}", [self.m_ids toJSONString], [self getEventString]];
+}
+
+#pragma mark - Private methods
+
+/**
+  Implements the internEventType method.
+*/
++ (NSString*)internEventType:(NSString*)anEventType {
+  if (anEventType == nil) {
+    return nil;
+  }
+  @synchronized(self) {
+    if (m_eventTypes == nil) {
+      m_eventTypes = [[NSMutableSet alloc] init];
+    }
+    NSString* result = [m_eventTypes member:anEventType];
+    if (result == nil) {
+      result = [anEventType copy];
+      [m_eventTypes addObject:result];
+    }
+    return result;
+  }
+}
+
+/**
+  Implements the internIDs method.
+*/
++ (IQUSDKIDs*)internIDs:(IQUSDKIDs*)anIDs {
+  if (anIDs == nil) {
+    return nil;
+  }
+  @synchronized(self) {
+    if (m_sharedIDs == nil) {
+      m_sharedIDs = [[NSMutableSet alloc] init];
+    }
+    IQUSDKIDs* result = [m_sharedIDs member:anIDs];
+    if (result == nil) {
+      // store a copy, anIDs might be changed by the caller
+      result = [anIDs clone];
+      [m_sharedIDs addObject:result];
+    }
+    return result;
+  }
+}
+
+/**
+  Implements the getEventString method.
+*/
+- (NSString*)getEventString {
+  return [[NSString alloc] initWithData:self.m_eventData encoding:NSUTF8StringEncoding];
 }
 
 #pragma mark - NSCoder
@@ -114,9 +238,10 @@ static NSString* const IdsKey = @"IDs";
 - (instancetype)initWithCoder:(NSCoder *)aCoder {
   self = [super init];
   if (self != nil) {
-    self.m_event = [aCoder decodeObjectForKey:EventKey];
-    self.m_ids = [aCoder decodeObjectForKey:IdsKey];
-    self->_eventType = [aCoder decodeObjectForKey:EventTypeKey];
+    NSString* event = [aCoder decodeObjectForKey:EventKey];
+    self.m_eventData = [event dataUsingEncoding:NSUTF8StringEncoding];
+    self.m_ids = [IQUSDKMessage internIDs:[aCoder decodeObjectForKey:IdsKey]];
+    self->_eventType = [IQUSDKMessage internEventType:[aCoder decodeObjectForKey:EventTypeKey]];
     self->_next = nil;
     self->_queue = nil;
   }
@@ -127,7 +252,7 @@ static NSString* const IdsKey = @"IDs";
   Implements the encodeWithCoder method.
 */
 - (void)encodeWithCoder:(NSCoder *)aCoder {
-  [aCoder encodeObject:self.m_event forKey:EventKey];
+  [aCoder encodeObject:[self getEventString] forKey:EventKey];
   [aCoder encodeObject:self.m_ids forKey:IdsKey];
   [aCoder encodeObject:self->_eventType forKey:EventTypeKey];
 }
@@ -1,5 +1,7 @@
 #import <Foundation/Foundation.h>
 #import "IQUSDKIDType.h"
+#import "IQUSDKMessageResult.h"
+#import "IQUSDKWireFormat.h"
 
 #pragma mark - Classes referenced
 
@@ -13,8 +15,25 @@
 */
 @interface IQUSDKMessageQueue : NSObject
 
+#pragma mark - Public properties
+
+/**
+  The maximum number of messages the queue can contain. When a message is added to a full queue, the oldest message
+  is destroyed. Lowering the value destroys the oldest messages until the queue fits. Use 0 for no limit.
+ 
+  The default value is 0.
+*/
+@property int maxCount;
+
 #pragma mark - Public methods
 
+/**
+  Initializes the instance using a specific file name to store the messages in.
+ 
+  @param aFileName Name of the file (without path) to store the messages in.
+*/
+- (instancetype)init:(NSString*)aFileName;
+
 /**
   Checks if the queue does not contain any message.
  
@@ -64,6 +83,7 @@
 
 /**
   Saves the messages to persistent storage. This method only performs the save if new messages have been added or one of the messages changed.
+  If messages were removed and the queue is empty, the persistently stored messages are cleared.
 */
 - (void)save;
 
@@ -73,12 +93,21 @@
 - (void)load;
 
 /**
-  Returns the queue as a JSON formatted string.
+  Returns the queue as a JSON formatted string using IQUSDKWireFormatList.
  
   @return JSON formatted string.
 */
 - (NSString*)toJSONString;
 
+/**
+  Returns the queue as a JSON formatted string using a certain format.
+ 
+  @param aFormat Format to use
+ 
+  @return JSON formatted string.
+*/
+- (NSString*)toJSONString:(IQUSDKWireFormat)aFormat;
+
 /**
   Update an id within all the stored messages.
  
@@ -97,6 +126,31 @@
 */
 - (bool)hasEventType:(NSString*)aType;
 
+/**
+  Processes the results returned by the server for the messages in this queue. The results are in the same order as
+  the messages. Accepted messages are destroyed, rejected messages are moved to aDeadLetters and all other messages
+  (including messages without a result) stay in the queue. Incomplete messages (without ids or event) are not part
+  of the sent JSON data, they have no result and are destroyed.
+ 
+  When the queue is empty afterwards, the persistently stored messages are cleared.
+ 
+  @param aResults NSArray with a NSNumber containing an IQUSDKMessageResult value for every message.
+  @param aDeadLetters Queue to move rejected messages to or nil to destroy them.
+ 
+  @return <code>true</code> if at least one message was accepted or rejected, <code>false</code> if all messages 
+          have to be sent again.
+*/
+- (bool)processResults:(NSArray*)aResults deadLetters:(IQUSDKMessageQueue*)aDeadLetters;
+
+/**
+  Moves messages to another queue, starting with the oldest message.
+ 
+  @param aQueue Queue to add the messages to
+  @param anEventType Only move messages of this event type or nil to move messages of any type
+  @param aMaxCount Maximum number of messages aQueue may contain after this call
+*/
+- (void)moveTo:(IQUSDKMessageQueue*)aQueue eventType:(NSString*)anEventType maxCount:(int)aMaxCount;
+
 /**
   This handler is called by IQUMessage when the contents changes.
  
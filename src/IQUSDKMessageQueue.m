@@ -2,6 +2,7 @@
 #import "IQUSDK.h"
 #import "IQUSDKMessageQueue.h"
 #import "IQUSDKMessage.h"
+#import "IQUSDKIDs.h"
 
 #pragma mark - PRIVATE DEFINITIONS
 
@@ -19,11 +20,26 @@
 */
 @property IQUSDKMessage* m_last;
 
+/**
+  Number of messages in the chain.
+*/
+@property int m_count;
+
+/**
+  File name including full path.
+*/
+@property NSString* m_fileName;
+
 /**
   Cached JSON string.
 */
 @property NSString* m_cachedJSONString;
 
+/**
+  Format of the cached JSON string.
+*/
+@property IQUSDKWireFormat m_cachedFormat;
+
 /**
   When true recreate JSON string.
 */
@@ -41,17 +57,70 @@
 */
 - (void)reset;
 
+/**
+  Destroys the oldest messages until the queue contains no more than a certain number of messages.
+ 
+  @param aMaxCount Maximum number of messages to keep
+*/
+- (void)limit:(int)aMaxCount;
+
 /**
   Deletes the storage file (if any).
 */
 - (void)deleteFile;
 
+/**
+  Removes a message from the chain, the message itself is not destroyed.
+ 
+  @param aMessage Message to remove
+  @param aPrevious Message before aMessage in the chain or nil if aMessage is the first message.
+*/
+- (void)remove:(IQUSDKMessage*)aMessage previous:(IQUSDKMessage*)aPrevious;
+
+/**
+  Checks if a message contains both ids and event data. Incomplete messages (for example loaded from a damaged version
+  1 file) are not saved or sent.
+ 
+  @param aMessage Message to check
+ 
+  @return <code>true</code> if the message is complete.
+*/
+- (bool)isComplete:(IQUSDKMessage*)aMessage;
+
 /**
   Builds the JSON string.
  
+  @param aFormat Format to use
+ 
   @return JSON formatted string.
 */
-- (NSString*)buildJSONString;
+- (NSString*)buildJSONString:(IQUSDKWireFormat)aFormat;
+
+/**
+  Gets the index of a set of ids within a list of distinct ids. If the ids are not in the list yet, they are added
+  to the end of the list.
+ 
+  @param anIDs Ids to get index for
+  @param aList List of distinct ids
+  @param aMap Maps ids to their index in aList
+ 
+  @return index within aList
+*/
+- (int)indexOfIDs:(IQUSDKIDs*)anIDs list:(NSMutableArray*)aList map:(NSMapTable*)aMap;
+
+/**
+  Loads messages stored with file version 1, where every message is stored with its own ids.
+ 
+  @param anUnarchiver Unarchiver to load messages from
+*/
+- (void)loadVersion1:(NSKeyedUnarchiver*)anUnarchiver;
+
+/**
+  Loads messages stored with file version 2, where every distinct set of ids is stored once.
+ 
+  @param anUnarchiver Unarchiver to load messages from
+*/
+- (void)loadVersion2:(NSKeyedUnarchiver*)anUnarchiver;
 
 @end
 
@@ -59,6 +128,8 @@
 
 @implementation IQUSDKMessageQueue
 
+@synthesize maxCount = _maxCount;
+
 #pragma mark - Private consts
 
 /**
@@ -69,7 +140,7 @@ static NSString* const FileName = @"IQUSDK_messages.bin";
 /**
   Version of file, increase if data structure changes.
 */
-static const int FileVersion = 1;
+static const int FileVersion = 2;
 
 /**
   Key used to store file version with.
@@ -77,16 +148,36 @@ static const int FileVersion = 1;
 static NSString* const VersionKey = @"Version";
 
 /**
-  Key used to store messages with.
+  Key used to store messages with (file version 1).
 */
 static NSString* const ListKey = @"Messages";
 
+/**
+  Key used to store the distinct ids with.
+*/
+static NSString* const IDsKey = @"IDs";
+
+/**
+  Key used to store the index of the ids for every message with.
+*/
+static NSString* const IDIndexesKey = @"IDIndexes";
+
+/**
+  Key used to store the events with.
+*/
+static NSString* const EventsKey = @"Events";
+
+/**
+  Key used to store the event types with.
+*/
+static NSString* const EventTypesKey = @"EventTypes";
+
 #pragma mark - Private static variables
 
 /**
-  FileName including full path.
+  Directory where the files are stored in.
 */
-static NSString* m_fileName = nil;
+static NSString* m_directory = nil;
 
 #pragma mark - Initializers
 
@@ -94,21 +185,48 @@ static NSString* m_fileName = nil;
   Initializes the instance.
 */
 - (id)init {
+  return [self init:FileName];
+}
+
+/**
+  Implements the init method.
+*/
+- (instancetype)init:(NSString*)aFileName {
   self = [super init];
   if (self != nil) {
     [self reset];
-    // filename has not been determined yet?
-    if (m_fileName == nil) {
-      // yes, create it now
+    self.maxCount = 0;
+    // directory has not been determined yet?
+    if (m_directory == nil) {
+      // yes, get it now
       NSArray* paths = NSSearchPathForDirectoriesInDomains(
           NSDocumentDirectory, NSUserDomainMask, YES);
-      NSString* documentsDirectory = [paths objectAtIndex:0];
-      m_fileName = [documentsDirectory stringByAppendingPathComponent:FileName];
+      m_directory = [paths objectAtIndex:0];
     }
+    self.m_fileName = [m_directory stringByAppendingPathComponent:aFileName];
   }
   return self;
 }
 
+#pragma mark - Property getters & setters
+
+/**
+  Implements maxCount setter, the oldest messages are destroyed if the queue contains more messages.
+*/
+- (void)setMaxCount:(int)aValue {
+  self->_maxCount = aValue;
+  if (aValue > 0) {
+    [self limit:aValue];
+  }
+}
+
+/**
+  Implements maxCount getter.
+*/
+- (int)maxCount {
+  return self->_maxCount;
+}
+
 #pragma mark - Public methods
 
 /**
@@ -122,6 +240,10 @@ static NSString* m_fileName = nil;
   Implements add method.
 */
 - (void)add:(IQUSDKMessage*)aMessage {
+  // queue is full? then destroy the oldest messages to make room
+  if (self.maxCount > 0) {
+    [self limit:self.maxCount - 1];
+  }
   if (self.m_last != nil) {
     self.m_last.next = aMessage;
   }
@@ -131,6 +253,7 @@ static NSString* m_fileName = nil;
   }
   // message now belongs to this queue
   aMessage.queue = self;
+  self.m_count++;
   self.m_dirtyJSON = true;
   self.m_dirtyStored = true;
 }
@@ -144,6 +267,7 @@ static NSString* m_fileName = nil;
     // else reset it.
     if ([self isEmpty]) {
       self.m_cachedJSONString = aQueue.m_cachedJSONString;
+      self.m_cachedFormat = aQueue.m_cachedFormat;
       self.m_dirtyJSON = aQueue.m_dirtyJSON;
       self.m_dirtyStored = aQueue.m_dirtyStored;
     } else {
@@ -164,6 +288,7 @@ static NSString* m_fileName = nil;
     }
     // chain starts now with the first message in the chain of aQueue
     self.m_first = first;
+    self.m_count += aQueue.m_count;
     // update queue property?
     if (aChangeQueue) {
       for (IQUSDKMessage* message = first; message != nil;
@@ -188,12 +313,7 @@ static NSString* m_fileName = nil;
   Implements getCount method.
 */
 - (int)getCount {
-  int result = 0;
-  for (IQUSDKMessage* message = self.m_first; message != nil;
-       message = message.next) {
-    result++;
-  }
-  return result;
+  return self.m_count;
 }
 
 /**
@@ -216,26 +336,46 @@ static NSString* m_fileName = nil;
   Implements save method.
 */
 - (void)save {
-  if (self.m_dirtyStored && ![self isEmpty]) {
-    // store all messages in an array
+  // all stored messages have been removed? (for example sent by another queue)
+  if (self.m_dirtyStored && [self isEmpty]) {
+    [self deleteFile];
+    self.m_dirtyStored = false;
+  } else if (self.m_dirtyStored) {
+    // store every distinct set of ids once and the index of the ids, the event and event type for every message
     int count = [self getCount];
-    NSMutableArray* list = [[NSMutableArray alloc] initWithCapacity:count];
+    NSMutableArray* ids = [[NSMutableArray alloc] init];
+    NSMapTable* idsMap = [NSMapTable strongToStrongObjectsMapTable];
+    NSMutableData* idIndexes = [[NSMutableData alloc] initWithLength:count * sizeof(uint32_t)];
+    uint32_t* idIndexBytes = (uint32_t*)idIndexes.mutableBytes;
+    NSMutableArray* events = [[NSMutableArray alloc] initWithCapacity:count];
+    NSMutableArray* eventTypes = [[NSMutableArray alloc] initWithCapacity:count];
+    int position = 0;
     for (IQUSDKMessage* message = self.m_first; message != nil;
          message = message.next) {
-      [list addObject:message];
+      if (![self isComplete:message]) {
+        continue;
+      }
+      int index = [self indexOfIDs:[message getIDs] list:ids map:idsMap];
+      idIndexBytes[position++] = NSSwapHostIntToLittle((unsigned int)index);
+      [events addObject:[message getEventData]];
+      [eventTypes addObject:(message.eventType == nil) ? @"" : message.eventType];
     }
+    idIndexes.length = position * sizeof(uint32_t);
     NSMutableData* data = [[NSMutableData alloc] init];
     NSKeyedArchiver* archiver =
         [[NSKeyedArchiver alloc] initForWritingWithMutableData:data];
     if (archiver) {
       [archiver encodeInt:FileVersion forKey:VersionKey];
-      [archiver encodeObject:list forKey:ListKey];
+      [archiver encodeObject:ids forKey:IDsKey];
+      [archiver encodeObject:idIndexes forKey:IDIndexesKey];
+      [archiver encodeObject:events forKey:EventsKey];
+      [archiver encodeObject:eventTypes forKey:EventTypesKey];
       [archiver finishEncoding];
-      [data writeToFile:m_fileName atomically:YES];
+      [data writeToFile:self.m_fileName atomically:YES];
 #ifdef IQUSDK_DEBUG
       [[IQUSDK instance]
           addLog:[NSString
-                     stringWithFormat:@"[Queue] saved %d messages.", count]];
+                     stringWithFormat:@"[Queue] saved %d messages.", position]];
 #endif
     }
     // messages have been saved
@@ -248,29 +388,20 @@ static NSString* m_fileName = nil;
 */
 - (void)load {
   [self clear:false];
-  if ([[NSFileManager defaultManager] fileExistsAtPath:m_fileName]) {
-    NSData* data = [NSData dataWithContentsOfFile:m_fileName];
+  // load all messages, the maximum is applied afterwards so the storage gets updated if messages were dropped
+  int maxCount = self.maxCount;
+  self->_maxCount = 0;
+  if ([[NSFileManager defaultManager] fileExistsAtPath:self.m_fileName]) {
+    NSData* data = [NSData dataWithContentsOfFile:self.m_fileName];
     if (data != nil) {
       NSKeyedUnarchiver* unarchiver =
           [[NSKeyedUnarchiver alloc] initForReadingWithData:data];
       if (unarchiver != nil) {
         int version = [unarchiver decodeIntForKey:VersionKey];
-        if (version == FileVersion) {
-          NSArray* list = (NSArray*)[unarchiver decodeObjectForKey:ListKey];
-          // convert list back to linked list and set queue property
-          if (list != nil) {
-            for (int index = 0; index < list.count; index++) {
-              IQUSDKMessage* message = [list objectAtIndex:index];
-              message.queue = self;
-              [self add:message];
-            }
-#ifdef IQUSDK_DEBUG
-            [[IQUSDK instance]
-                addLog:[NSString
-                           stringWithFormat:@"[Queue] loaded %d messages.",
-                                            list.count]];
-#endif
-          }
+        if (version == 1) {
+          [self loadVersion1:unarchiver];
+        } else if (version == FileVersion) {
+          [self loadVersion2:unarchiver];
         } else {
           // unsupported version, so delete file
           [self deleteFile];
@@ -281,14 +412,23 @@ static NSString* m_fileName = nil;
   }
   // no need to save the just loaded messages
   self.m_dirtyStored = false;
+  self.maxCount = maxCount;
 }
 
 /**
   Implements toJSONString method.
 */
 - (NSString*)toJSONString {
-  if ((self.m_cachedJSONString == nil) || self.m_dirtyJSON) {
-    self.m_cachedJSONString = [self buildJSONString];
+  return [self toJSONString:IQUSDKWireFormatList];
+}
+
+/**
+  Implements toJSONString: method.
+*/
+- (NSString*)toJSONString:(IQUSDKWireFormat)aFormat {
+  if ((self.m_cachedJSONString == nil) || self.m_dirtyJSON || (self.m_cachedFormat != aFormat)) {
+    self.m_cachedJSONString = [self buildJSONString:aFormat];
+    self.m_cachedFormat = aFormat;
     self.m_dirtyJSON = false;
   }
   return self.m_cachedJSONString;
@@ -316,6 +456,81 @@ static NSString* m_fileName = nil;
   return false;
 }
 
+/**
+  Implements the processResults method.
+*/
+- (bool)processResults:(NSArray*)aResults deadLetters:(IQUSDKMessageQueue*)aDeadLetters {
+  bool result = false;
+  bool removed = false;
+  int index = 0;
+  IQUSDKMessage* previous = nil;
+  IQUSDKMessage* message = self.m_first;
+  while (message != nil) {
+    IQUSDKMessage* next = message.next;
+    // incomplete messages were not sent (so have no result) and can never be sent, so destroy them
+    if (![self isComplete:message]) {
+      [self remove:message previous:previous];
+      [message destroy];
+      message = next;
+      removed = true;
+      continue;
+    }
+    // messages without result are sent again
+    IQUSDKMessageResult messageResult =
+        (index < aResults.count) ? [[aResults objectAtIndex:index] integerValue] : IQUSDKMessageResultRetry;
+    if (messageResult == IQUSDKMessageResultRetry) {
+      previous = message;
+    } else {
+      [self remove:message previous:previous];
+      if ((messageResult == IQUSDKMessageResultRejected) && (aDeadLetters != nil)) {
+#ifdef IQUSDK_DEBUG
+        [[IQUSDK instance]
+            addLog:[NSString stringWithFormat:@"[Queue] message rejected: %@", [message toJSONString]]];
+#endif
+        [aDeadLetters add:message];
+      } else {
+        [message destroy];
+      }
+      result = true;
+    }
+    message = next;
+    index++;
+  }
+  if (result || removed) {
+    if ([self isEmpty]) {
+      [self clear:true];
+    } else {
+      self.m_dirtyJSON = true;
+      self.m_dirtyStored = true;
+    }
+  }
+  return result;
+}
+
+/**
+  Implements the moveTo method.
+*/
+- (void)moveTo:(IQUSDKMessageQueue*)aQueue eventType:(NSString*)anEventType maxCount:(int)aMaxCount {
+  bool moved = false;
+  IQUSDKMessage* previous = nil;
+  IQUSDKMessage* message = self.m_first;
+  while ((message != nil) && (aQueue.m_count < aMaxCount)) {
+    IQUSDKMessage* next = message.next;
+    if ((anEventType == nil) || [anEventType isEqualToString:message.eventType]) {
+      [self remove:message previous:previous];
+      [aQueue add:message];
+      moved = true;
+    } else {
+      previous = message;
+    }
+    message = next;
+  }
+  if (moved) {
+    self.m_dirtyJSON = true;
+    self.m_dirtyStored = true;
+  }
+}
+
 /**
   Implements the onMessageChanged method.
 */
@@ -329,12 +544,42 @@ static NSString* m_fileName = nil;
 /**
   Implements buildJSONString method.
 */
-- (NSString*)buildJSONString {
+- (NSString*)buildJSONString:(IQUSDKWireFormat)aFormat {
   NSMutableString* result = [[NSMutableString alloc] init];
+  if (aFormat == IQUSDKWireFormatGrouped) {
+    // build messages while collecting the distinct ids
+    NSMutableArray* ids = [[NSMutableArray alloc] init];
+    NSMapTable* idsMap = [NSMapTable strongToStrongObjectsMapTable];
+    NSMutableString* messages = [[NSMutableString alloc] init];
+    for (IQUSDKMessage* message = self.m_first; message != nil;
+         message = message.next) {
+      if (![self isComplete:message]) {
+        continue;
+      }
+      if (messages.length > 0) {
+        [messages appendString:@","];
+      }
+      [messages appendString:[message toJSONString:[self indexOfIDs:[message getIDs] list:ids map:idsMap]]];
+    }
+    [result appendString:@"{\"identifiers\":["];
+    for (int index = 0; index < ids.count; index++) {
+      if (index > 0) {
+        [result appendString:@","];
+      }
+      [result appendString:[[ids objectAtIndex:index] toJSONString]];
+    }
+    [result appendString:@"],\"messages\":["];
+    [result appendString:messages];
+    [result appendString:@"]}"];
+    return result;
+  }
   [result appendString:@"["];
   bool notEmpty = false;
   for (IQUSDKMessage* message = self.m_first; message != nil;
        message = message.next) {
+    if (![self isComplete:message]) {
+      continue;
+    }
     if (notEmpty) {
       [result appendString:@","];
     }
@@ -345,15 +590,122 @@ static NSString* m_fileName = nil;
   return result;
 }
 
+/**
+  Implements the isComplete method.
+*/
+- (bool)isComplete:(IQUSDKMessage*)aMessage {
+  return ([aMessage getEventData] != nil) && ([aMessage getIDs] != nil);
+}
+
+/**
+  Implements the indexOfIDs method.
+*/
+- (int)indexOfIDs:(IQUSDKIDs*)anIDs list:(NSMutableArray*)aList map:(NSMapTable*)aMap {
+  NSNumber* index = [aMap objectForKey:anIDs];
+  if (index == nil) {
+    index = @(aList.count);
+    [aList addObject:anIDs];
+    [aMap setObject:index forKey:anIDs];
+  }
+  return index.intValue;
+}
+
+/**
+  Implements the loadVersion1 method.
+*/
+- (void)loadVersion1:(NSKeyedUnarchiver*)anUnarchiver {
+  NSArray* list = (NSArray*)[anUnarchiver decodeObjectForKey:ListKey];
+  // convert list back to linked list and set queue property
+  if (list != nil) {
+    for (int index = 0; index < list.count; index++) {
+      IQUSDKMessage* message = [list objectAtIndex:index];
+      message.queue = self;
+      [self add:message];
+    }
+#ifdef IQUSDK_DEBUG
+    [[IQUSDK instance]
+        addLog:[NSString
+                   stringWithFormat:@"[Queue] loaded %lu messages.",
+                                    (unsigned long)list.count]];
+#endif
+  }
+}
+
+/**
+  Implements the loadVersion2 method.
+*/
+- (void)loadVersion2:(NSKeyedUnarchiver*)anUnarchiver {
+  NSArray* ids = (NSArray*)[anUnarchiver decodeObjectForKey:IDsKey];
+  NSData* idIndexes = (NSData*)[anUnarchiver decodeObjectForKey:IDIndexesKey];
+  NSArray* events = (NSArray*)[anUnarchiver decodeObjectForKey:EventsKey];
+  NSArray* eventTypes = (NSArray*)[anUnarchiver decodeObjectForKey:EventTypesKey];
+  // ignore incomplete data
+  if ((ids == nil) || (idIndexes == nil) || (events == nil) || (eventTypes == nil) ||
+      (eventTypes.count != events.count) || (idIndexes.length != events.count * sizeof(uint32_t))) {
+    return;
+  }
+  const uint32_t* idIndexBytes = (const uint32_t*)idIndexes.bytes;
+  for (int index = 0; index < events.count; index++) {
+    unsigned int idIndex = NSSwapLittleIntToHost(idIndexBytes[index]);
+    if (idIndex >= ids.count) {
+      continue;
+    }
+    [self add:[[IQUSDKMessage alloc] init:[ids objectAtIndex:idIndex]
+                                eventData:[events objectAtIndex:index]
+                                eventType:[eventTypes objectAtIndex:index]]];
+  }
+#ifdef IQUSDK_DEBUG
+  [[IQUSDK instance]
+      addLog:[NSString
+                 stringWithFormat:@"[Queue] loaded %lu messages with %lu distinct ids.",
+                                  (unsigned long)events.count, (unsigned long)ids.count]];
+#endif
+}
+
+/**
+  Implements the remove method.
+*/
+- (void)remove:(IQUSDKMessage*)aMessage previous:(IQUSDKMessage*)aPrevious {
+  if (aPrevious == nil) {
+    self.m_first = aMessage.next;
+  } else {
+    aPrevious.next = aMessage.next;
+  }
+  if (self.m_last == aMessage) {
+    self.m_last = aPrevious;
+  }
+  self.m_count--;
+  aMessage.next = nil;
+}
+
+/**
+  Implements the limit method.
+*/
+- (void)limit:(int)aMaxCount {
+  bool removed = false;
+  while ((self.m_first != nil) && (self.m_count > aMaxCount)) {
+    IQUSDKMessage* first = self.m_first;
+    [self remove:first previous:nil];
+    [first destroy];
+    removed = true;
+  }
+  if (removed) {
+    self.m_dirtyJSON = true;
+    self.m_dirtyStored = true;
+  }
+}
+
 /**
   Implements reset method.
 */
 - (void)reset {
   self.m_first = nil;
   self.m_last = nil;
+  self.m_count = 0;
   self.m_dirtyJSON = false;
   self.m_dirtyStored = false;
   self.m_cachedJSONString = nil;
+  self.m_cachedFormat = IQUSDKWireFormatList;
 }
 
 /**
@@ -361,9 +713,9 @@ static NSString* m_fileName = nil;
 */
 - (void)deleteFile {
   NSFileManager* manager = [NSFileManager defaultManager];
-  if ([manager fileExistsAtPath:m_fileName]) {
+  if ([manager fileExistsAtPath:self.m_fileName]) {
     NSError* error;
-    [manager removeItemAtPath:m_fileName error:&error];
+    [manager removeItemAtPath:self.m_fileName error:&error];
 #ifdef IQUSDK_DEBUG
     [[IQUSDK instance] addLog:@"[Queue] deleting persistent storage file."];
 #endif
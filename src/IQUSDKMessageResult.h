@@ -0,0 +1,21 @@
+#import <Foundation/Foundation.h>
+
+/**
+  IQUSDKMessageResult defines the result the server can return for a single message that was sent.
+*/
+typedef NS_ENUM(NSInteger, IQUSDKMessageResult) {
+  /**
+    The server accepted the message.
+  */
+  IQUSDKMessageResultAccepted = 0,
+
+  /**
+    The server rejected the message permanently; sending it again will not help.
+  */
+  IQUSDKMessageResultRejected = 1,
+
+  /**
+    The server could not process the message (yet); it should be sent again.
+  */
+  IQUSDKMessageResultRetry = 2
+};
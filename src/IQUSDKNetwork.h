@@ -1,24 +1,42 @@
 #import <Foundation/Foundation.h>
 #import "IQUSDKMessageQueue.h"
+#import "IQUSDKTransport.h"
+#import "IQUSDKHMAC.h"
 
 #pragma mark - INTERFACE
 
 /**
   IQUNetwork takes care of sending data to the IQU server. It assumes the network IO related methods are called from a separate thread 
   and can block until the IO action has finished.
+ 
+  The actual HTTP communication and signing are performed by IQUSDKTransport and IQUSDKHMAC implementations.
 */
 @interface IQUSDKNetwork : NSObject
 
 #pragma mark - Public methods
 
 /**
-  Initializes a new instance of the class.
+  Initializes a new instance of the class using the default transport and HMAC implementations for the platform (see
+  IQUSDKConfig.h).
  
   @param anApiKey API key
   @param aSecretKey Secret key
 */
 - (instancetype)init:(NSString*)anApiKey secretKey:(NSString*)aSecretKey;
 
+/**
+  Initializes a new instance of the class using specific transport and HMAC implementations.
+ 
+  @param anApiKey API key
+  @param aSecretKey Secret key
+  @param aTransport Transport to communicate with the server
+  @param anHMAC HMAC implementation to sign the messages with
+*/
+- (instancetype)init:(NSString*)anApiKey
+           secretKey:(NSString*)aSecretKey
+           transport:(id<IQUSDKTransport>)aTransport
+                hmac:(id<IQUSDKHMAC>)anHMAC;
+
 /**
   Cleans up references and resources.
 */
@@ -27,11 +45,26 @@
 /**
   Tries to send one or more messages to server.
  
+  If the server returns a result for every message, those results are returned. If the server only returns an overall
+  status of "ok", every message is considered to be accepted.
+ 
+  @param aMessages MessageQueue to send
+ 
+  @return NSArray with a NSNumber containing an IQUSDKMessageResult value for every message in aMessages or nil if 
+          sending failed.
+*/
+- (NSArray*)send:(IQUSDKMessageQueue*)aMessages;
+
+/**
+  Tries to send one or more messages to server using a specific time-out instead of [IQUSDK instance].sendTimeout.
+ 
   @param aMessages MessageQueue to send
+  @param aTimeout Maximum time in milliseconds sending may take.
  
-  @return <code>true</code> if sending was successful, <code>false</code> if not.
+  @return NSArray with a NSNumber containing an IQUSDKMessageResult value for every message in aMessages or nil if 
+          sending failed.
 */
-- (bool)send:(IQUSDKMessageQueue*)aMessages;
+- (NSArray*)send:(IQUSDKMessageQueue*)aMessages timeout:(int)aTimeout;
 
 /**
   Tries to send a small message to the server to see if it is reachable.
@@ -1,9 +1,19 @@
-#import <CommonCrypto/CommonDigest.h>
-#import <CommonCrypto/CommonHMAC.h>
 #import "IQUSDKConfig.h"
 #import "IQUSDKNetwork.h"
 #import "IQUSDK.h"
 #import "IQUSDKUtils.h"
+#ifdef IQUSDK_URLCONNECTION
+#import "IQUSDKURLConnectionTransport.h"
+#endif
+#ifdef IQUSDK_CURL
+#import "IQUSDKCurlTransport.h"
+#endif
+#ifdef IQUSDK_COMMONCRYPTO
+#import "IQUSDKCommonCryptoHMAC.h"
+#endif
+#ifdef IQUSDK_OPENSSL
+#import "IQUSDKOpenSSLHMAC.h"
+#endif
 
 #pragma mark - PRIVATE DEFINITIONS
 
@@ -27,42 +37,22 @@
 @property bool m_cancel;
 
 /**
-  Result of an URL request.
-*/
-@property NSDictionary* m_result;
-
-/**
-  Data received from server.
-*/
-@property NSMutableData* m_responseData;
-
-/**
-  Response received.
+  Transport used to communicate with the server.
 */
-@property NSHTTPURLResponse* m_httpResponse;
+@property id<IQUSDKTransport> m_transport;
 
 /**
-  Will contain the current active connection.
+  HMAC implementation used to sign the messages.
 */
-@property NSURLConnection* m_connection;
+@property id<IQUSDKHMAC> m_hmac;
 
 #pragma mark - Private methods
 
 /**
-  Sleep for 1 second, unless IO got cancelled.
+  Sleep for 1 second (using the active clock), unless IO got cancelled.
 */
 - (void)sleepThread;
 
-/**
-   Generates a SHA512 hash and returns the hash as a hex string.
-
-   @param aText Text to generate hash for
-   @param aKey  Key to use to generate hash
-
-   @return hash as hex string
-*/
-- (NSString*)sha512:(NSString*)aText withKey:(NSString*)aKey;
-
 /**
   Simulate off-line behaviour. The method waits for 1 second and then returns a NSDictionary with only an error field.
 
@@ -83,43 +73,29 @@
 - (NSDictionary*)simulateServer:(NSString*)anURL postContent:(NSString*)aPostContent;
 
 /**
-   Creates a request from an URL and optional POST data.
+  Parses the data returned by the transport as JSON.
 
-   @param anURL        URL to send request to
-   @param aPostContent POST data or nil if there is no POST data.
+  @param aResponse Result returned by the transport
 
-   @return NSURLRequest instance.
+  @return NSDictionary with the parsed JSON data and the status code or with an error field.
 */
-- (NSURLRequest*)createRequest:(NSString*)anURL postContent:(NSString*)aPostContent;
-
-/**
-   Sends data to the server.
-
-   @param aRequest Request contains the URL and optional POST data.
-*/
-- (void)sendData:(NSURLRequest*)aRequest;
-
-/**
-   Checks if a http response was received and add statusCode to the dictionary if it did.
-
-   @param aDictionary Dictionary to add code to (if any)
-*/
-- (void)addStatusCode:(NSMutableDictionary*)aDictionary;
+- (NSDictionary*)parseResponse:(NSDictionary*)aResponse;
 
 /**
   Sends a request to the server and processes the result.
 
   If an error occurred while sending, the result will contain a field
-  ERROR.
+  IQUSDKTransportErrorKey.
 
-  The response code (if any) is stored in the field CODE.
+  The response code (if any) is stored in the field IQUSDKTransportCodeKey.
 
   @param anURL URL to send request to
   @param aPostContent POST content to send or null if there is no POST content.
+  @param aTimeout Maximum time in milliseconds the request may take.
 
   @return NSDictionary with result
 */
-- (NSDictionary*)send:(NSString*)anURL postContent:(NSString*)aPostContent;
+- (NSDictionary*)send:(NSString*)anURL postContent:(NSString*)aPostContent timeout:(int)aTimeout;
 
 /**
   Determines signature from post content, adds it to the url as parameters and continue with normal send operation. The
@@ -127,90 +103,73 @@
 
   @param anURL URL to send content to and to add parameters to
   @param aPostContent POST content to send
+  @param aTimeout Maximum time in milliseconds the request may take.
 
   @return NSDictionary instance with result
 */
-- (NSDictionary*)sendSigned:(NSString*)anURL postContent:(NSString*)aPostContent;
-
-#pragma mark - NSURLConnection callbacks
+- (NSDictionary*)sendSigned:(NSString*)anURL postContent:(NSString*)aPostContent timeout:(int)aTimeout;
 
 /**
-  This method is called from NSURLConnection and handles the response received from the server.
+  Converts the results per message returned by the server to IQUSDKMessageResult values. Every entry is either a 
+  status string or an object containing a status field. A status of "ok" means the message was accepted, "rejected" 
+  means the message was rejected permanently; with any other status or missing entries the message should be sent 
+  again.
 
-  @param aConnection Connection calling this method.
-  @param aResponse   Response received from the server.
-*/
-- (void)connection:(NSURLConnection*)aConnection didReceiveResponse:(NSURLResponse*)aResponse;
-
-/**
-  This method is called from NSURLConnction and handles any data received from the server.
+  @param aResults Results as returned by the server
+  @param aCount Number of messages that were sent
 
-  @param aConnection Connection calling this method.
-  @param aData       Data received from the server.
+  @return NSArray with aCount NSNumber instances containing an IQUSDKMessageResult value.
 */
-- (void)connection:(NSURLConnection*)aConnection didReceiveData:(NSData*)aData;
+- (NSArray*)parseResults:(NSArray*)aResults count:(int)aCount;
 
-/**
-  This method is called from NSURLConnection, it just returns nil to disable any caching.
-
-  @param aConnection     Connection calling this method.
-  @param aCachedResponse NSCachedURLResponse instance.
-
-  @return will return nil
-*/
-- (NSCachedURLResponse*)connection:(NSURLConnection*)aConnection
-                 willCacheResponse:(NSCachedURLResponse*)aCachedResponse;
-
-/**
-   This method is called from NSURLConnection when all response data has been received successfully.
+@end
 
-   @param aConnection Connection calling this method.
-*/
-- (void)connectionDidFinishLoading:(NSURLConnection*)aConnection;
+#pragma mark - Public consts
 
-/**
-   This method is called from NSURLConnection and handles any error that occurred.
+NSString* const IQUSDKTransportCodeKey = @"RESPONSE_CODE";
 
-   @param aConnection Connection calling this method
-   @param anError     Error that occurred
-*/
-- (void)connection:(NSURLConnection*)aConnection didFailWithError:(NSError*)anError;
+NSString* const IQUSDKTransportErrorKey = @"RESPONSE_ERROR";
 
-@end
+NSString* const IQUSDKTransportDataKey = @"RESPONSE_DATA";
 
 #pragma mark - IMPLEMENTATION
 
 @implementation IQUSDKNetwork
 
-#pragma mark - Private consts
-
-/**
-  The key value for status code from the response.
-*/
-static NSString* const CODE = @"RESPONSE_CODE";
-
-/**
-  The key value for error codes.
-*/
-static NSString* const ERROR = @"RESPONSE_ERROR";
+#pragma mark - Initializers
 
 /**
-  URL to communicate with server with.
+  Implements the init method.
 */
-static NSString* const URL = @"https://tracker.iqugroup.com/v3/";
-
-#pragma mark - Initializers
+- (instancetype)init:(NSString*)anApiKey secretKey:(NSString*)aSecretKey {
+#if defined(IQUSDK_CURL)
+  id<IQUSDKTransport> transport = [[IQUSDKCurlTransport alloc] init];
+#else
+  id<IQUSDKTransport> transport = [[IQUSDKURLConnectionTransport alloc] init];
+#endif
+#if defined(IQUSDK_OPENSSL)
+  id<IQUSDKHMAC> hmac = [[IQUSDKOpenSSLHMAC alloc] init];
+#else
+  id<IQUSDKHMAC> hmac = [[IQUSDKCommonCryptoHMAC alloc] init];
+#endif
+  return [self init:anApiKey secretKey:aSecretKey transport:transport hmac:hmac];
+}
 
 /**
   Implements the init method.
 */
-- (instancetype)init:(NSString*)anApiKey secretKey:(NSString*)aSecretKey {
+- (instancetype)init:(NSString*)anApiKey
+           secretKey:(NSString*)aSecretKey
+           transport:(id<IQUSDKTransport>)aTransport
+                hmac:(id<IQUSDKHMAC>)anHMAC {
   self = [super init];
   if (self != nil) {
     // initialize
     self.m_apiKey = anApiKey;
     self.m_secretKey = aSecretKey;
     self.m_cancel = false;
+    self.m_transport = aTransport;
+    self.m_hmac = anHMAC;
   }
   return self;
 }
@@ -220,21 +179,41 @@ static NSString* const URL = @"https://tracker.iqugroup.com/v3/";
 /**
   Implements the send method.
 */
-- (bool)send:(IQUSDKMessageQueue*)aMessages {
+- (NSArray*)send:(IQUSDKMessageQueue*)aMessages {
+  return [self send:aMessages timeout:[IQUSDK instance].sendTimeout];
+}
+
+/**
+  Implements the send:timeout method.
+*/
+- (NSArray*)send:(IQUSDKMessageQueue*)aMessages timeout:(int)aTimeout {
+  // get count before sending, the queue does not change while it is being sent
+  int count = [aMessages getCount];
   // send with signature
-  NSDictionary* result = [self sendSigned:URL postContent:[aMessages toJSONString]];
-  // result contains ERROR key then an error occurred
-  if ([result valueForKey:ERROR] != nil) {
-    return false;
+  NSDictionary* result = [self sendSigned:[IQUSDK instance].serverURL
+                              postContent:[aMessages toJSONString:[IQUSDK instance].wireFormat]
+                                  timeout:aTimeout];
+  // result contains error key then an error occurred
+  if ([result valueForKey:IQUSDKTransportErrorKey] != nil) {
+    return nil;
+  }
+  // server returned a result for every message?
+  NSArray* results = [result valueForKey:@"results"];
+  if ([results isKindOfClass:[NSArray class]]) {
+    return [self parseResults:results count:count];
   }
   // get status
   NSString* status = [result valueForKey:@"status"];
-  // if it does not exists an error occurred
-  if (status == nil) {
-    return false;
-  }
   // status should be 'ok' for a successful transaction
-  return [status isEqualToString:@"ok"];
+  if ((status == nil) || ![status isEqual:@"ok"]) {
+    return nil;
+  }
+  // all messages were accepted
+  NSMutableArray* accepted = [[NSMutableArray alloc] initWithCapacity:count];
+  for (int index = 0; index < count; index++) {
+    [accepted addObject:@(IQUSDKMessageResultAccepted)];
+  }
+  return accepted;
 }
 
 /**
@@ -242,8 +221,10 @@ static NSString* const URL = @"https://tracker.iqugroup.com/v3/";
 */
 - (bool)checkServer {
   // just see if ?ping can be reached
-  NSDictionary* result = [self send:[NSString stringWithFormat:@"%@?ping", URL] postContent:nil];
-  return [result valueForKey:ERROR] == nil;
+  NSDictionary* result = [self send:[NSString stringWithFormat:@"%@?ping", [IQUSDK instance].serverURL]
+                        postContent:nil
+                            timeout:[IQUSDK instance].sendTimeout];
+  return [result valueForKey:IQUSDKTransportErrorKey] == nil;
 }
 
 /**
@@ -251,6 +232,7 @@ static NSString* const URL = @"https://tracker.iqugroup.com/v3/";
 */
 - (void)cancelSend {
   self.m_cancel = true;
+  [self.m_transport cancel];
 }
 
 /**
@@ -259,11 +241,12 @@ static NSString* const URL = @"https://tracker.iqugroup.com/v3/";
 - (void)destroy {
   // stop any io
   self.m_cancel = true;
-  // clear reference to connection
-  self.m_connection = nil;
-  self.m_httpResponse = nil;
-  self.m_responseData = nil;
-  self.m_result = nil;
+  // clear references to the backends
+  if (self.m_transport != nil) {
+    [self.m_transport destroy];
+    self.m_transport = nil;
+  }
+  self.m_hmac = nil;
 }
 
 #pragma - Private methods
@@ -272,27 +255,12 @@ static NSString* const URL = @"https://tracker.iqugroup.com/v3/";
   Implements the sleepThread method.
 */
 - (void)sleepThread {
+  // the delay stands in for the IO time of a request, so it uses the SDK clock (a virtual clock will not block)
   for (int count = 0; count < 100; count++) {
     if (self.m_cancel)
       break;
-    [NSThread sleepForTimeInterval:0.01f];
-  }
-}
-
-/**
-  Generates a SHA512 hash and returns as a hex string.
-*/
-- (NSString*)sha512:(NSString*)aText withKey:(NSString*)aKey {
-  const char* key = [aKey cStringUsingEncoding:NSUTF8StringEncoding];
-  const char* data = [aText cStringUsingEncoding:NSUTF8StringEncoding];
-  unsigned char digest[CC_SHA512_DIGEST_LENGTH];
-  CCHmac(kCCHmacAlgSHA512, key, strlen(key), data, strlen(data), digest);
-  // convert digest to hex string
-  NSMutableString* hash = [NSMutableString stringWithCapacity:CC_SHA512_DIGEST_LENGTH * 2];
-  for (int i = 0; i < CC_SHA512_DIGEST_LENGTH; i++) {
-    [hash appendFormat:@"%02x", digest[i]];
+    [IQUSDKUtils sleep:10];
   }
-  return hash;
 }
 
 /**
@@ -306,7 +274,7 @@ static NSString* const URL = @"https://tracker.iqugroup.com/v3/";
   [self sleepThread];
   // return object with only error message
   NSDictionary* result = @{
-    ERROR : @"simulating offline [IQUSDK instance].testMode == " @"IQUSDKTestModeSimulateOffline"
+    IQUSDKTransportErrorKey : @"simulating offline [IQUSDK instance].testMode == " @"IQUSDKTestModeSimulateOffline"
   };
   return result;
 }
@@ -324,101 +292,45 @@ static NSString* const URL = @"https://tracker.iqugroup.com/v3/";
     @"request_id" : @"2a7-558bf465ed65-b79a84",
     @"time" : @"2015-06-26 12:00:00 UTC",
     @"status" : @"ok",
-    CODE : @(200)
+    IQUSDKTransportCodeKey : @(200)
   };
   return result;
 }
 
 /**
-  Implements the createRequest method.
+  Implements the parseResponse method.
 */
-- (NSURLRequest*)createRequest:(NSString*)anURL postContent:(NSString*)aPostContent {
-  // create the request
-  NSMutableURLRequest* request =
-      [NSMutableURLRequest requestWithURL:[NSURL URLWithString:anURL]
-                              cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
-                          timeoutInterval:((NSTimeInterval)[IQUSDK instance].sendTimeout) / 1000];
-  // initialize request without or with POST content
-  if (aPostContent == nil) {
-    // no post content, so use GET
-    request.HTTPMethod = @"GET";
-  } else {
-    // do post request for parameter passing
-    request.HTTPMethod = @"POST";
-    // set the content type to JSON
-    [request setValue:@"application/json" forHTTPHeaderField:@"Content-Type"];
-    // set body
-    request.HTTPBody = [aPostContent dataUsingEncoding:NSUTF8StringEncoding];
-    // store length of POST data
-    NSString* postLength = [NSString stringWithFormat:@"%d", request.HTTPBody.length];
-    [request setValue:postLength forHTTPHeaderField:@"Content-Length"];
+- (NSDictionary*)parseResponse:(NSDictionary*)aResponse {
+  NSData* data = [aResponse objectForKey:IQUSDKTransportDataKey];
+  // transport failed?
+  if (data == nil) {
+    return aResponse;
   }
-  // set SDK version and type in header
-  [request addValue:@IQUSDK_VERSION forHTTPHeaderField:@"SdkVersion"];
-  [request addValue:@IQUSDK_TYPE forHTTPHeaderField:@"SdkType"];
-  return request;
-}
-
-/**
-  Implements the sendData method.
-*/
-- (void)sendData:(NSURLRequest*)aRequest {
-  // reset vars (some will be set by the delegate callbacks)
-  self.m_result = nil;
-  self.m_responseData = nil;
-  self.m_httpResponse = nil;
-  self.m_connection = nil;
-  // get end time
-  int64_t endTime = [IQUSDKUtils currentTimeMillis] + (int64_t)[IQUSDK instance].sendTimeout;
-  // create connection using a separate queue
-  dispatch_queue_t downloadQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
-  dispatch_async(downloadQueue, ^{
-    // create connection and start sending data
-    self.m_connection = [[NSURLConnection alloc] initWithRequest:aRequest delegate:self startImmediately:YES];
-    // connection was not created?
-    if (self.m_connection == nil) {
-      // set result
-      self.m_result = @{ ERROR : @"error: connection could not be created." };
+  // parse received data as JSON
+  NSError* jsonError;
+  NSMutableDictionary* result = [NSJSONSerialization JSONObjectWithData:data
+                                                                options:NSJSONReadingMutableContainers
+                                                                  error:&jsonError];
+  if (![result isKindOfClass:[NSMutableDictionary class]]) {
+    result = [[NSMutableDictionary alloc] initWithCapacity:2];
+    if (jsonError == nil) {
+      [result setObject:@"error in json data received" forKey:IQUSDKTransportErrorKey];
+    } else {
+      [result setObject:jsonError.localizedDescription forKey:IQUSDKTransportErrorKey];
     }
-    [[NSRunLoop currentRunLoop] run];
-  });
-  // wait till either IO has finished, IO is cancelled or time-out has occurred
-  while ((self.m_result == nil) && !self.m_cancel && ([IQUSDKUtils currentTimeMillis] < endTime)) {
-    [NSThread sleepForTimeInterval:0.01f];
-  }
-  // connection was not reset while busy?
-  if (self.m_connection != nil) {
-    // cancel io
-    [self.m_connection cancel];
-  }
-  // clear references
-  self.m_connection = nil;
-  self.m_responseData = nil;
-  self.m_httpResponse = nil;
-  // cancelled?
-  if (self.m_cancel) {
-    self.m_result = @{ ERROR : @"error: io was cancelled." };
-  }
-  // not finished?
-  else if (self.m_result == nil) {
-    self.m_result = @{ ERROR : @"error: io did not finish in time (timeout error)." };
   }
-}
-
-/**
-  Implements the addStatusCode method.
-*/
-- (void)addStatusCode:(NSMutableDictionary*)aDictionary {
-  // received http response?
-  if (self.m_httpResponse != nil) {
-    [aDictionary setObject:@(self.m_httpResponse.statusCode) forKey:CODE];
+  // add status code from http response (if any)
+  NSNumber* code = [aResponse objectForKey:IQUSDKTransportCodeKey];
+  if (code != nil) {
+    [result setObject:code forKey:IQUSDKTransportCodeKey];
   }
+  return result;
 }
 
 /**
-  Implements the send:postContent method.
+  Implements the send:postContent:timeout method.
 */
-- (NSDictionary*)send:(NSString*)anURL postContent:(NSString*)aPostContent {
+- (NSDictionary*)send:(NSString*)anURL postContent:(NSString*)aPostContent timeout:(int)aTimeout {
 #ifdef IQUSDK_DEBUG
   // add info to debug
   [[IQUSDK instance] addLog:[NSString stringWithFormat:@"[Network][Sending] %@", anURL]];
@@ -435,122 +347,50 @@ static NSString* const URL = @"https://tracker.iqugroup.com/v3/";
     default:
       break;
   }
-  // create request
-  NSURLRequest* request = [self createRequest:anURL postContent:aPostContent];
   // perform IO and wait for it to finish
-  [self sendData:request];
+  NSDictionary* result = [self parseResponse:[self.m_transport send:anURL
+                                                         postContent:aPostContent
+                                                             timeout:aTimeout]];
 #ifdef IQUSDK_DEBUG
-  [[IQUSDK instance] addLog:[NSString stringWithFormat:@"[Network][Result] %@", self.m_result]];
+  [[IQUSDK instance] addLog:[NSString stringWithFormat:@"[Network][Result] %@", result]];
 #endif
   // reset cancel for next time
   self.m_cancel = false;
   // done
-  return self.m_result;
+  return result;
 }
 
 /**
   Implements the sendSigned method.
 */
-- (NSDictionary*)sendSigned:(NSString*)anURL postContent:(NSString*)aPostContent {
+- (NSDictionary*)sendSigned:(NSString*)anURL postContent:(NSString*)aPostContent timeout:(int)aTimeout {
   // determine hash
-  NSString* hash = [self sha512:aPostContent withKey:self.m_secretKey];
+  NSString* hash = [self.m_hmac sha512:aPostContent withKey:self.m_secretKey];
   // add api key and signature to url and continue with normal send action
   return [self send:[NSString stringWithFormat:@"%@?api_key=%@&signature=%@", anURL, self.m_apiKey, hash]
-        postContent:aPostContent];
+        postContent:aPostContent
+            timeout:aTimeout];
 }
 
-#pragma mark - NSURLConnection callbacks
-
 /**
-  Implements the connection:didReceiveResponse method.
+  Implements the parseResults method.
 */
-- (void)connection:(NSURLConnection*)aConnection didReceiveResponse:(NSURLResponse*)aResponse {
-  // ignore if it is not the current connection
-  if (aConnection != self.m_connection) {
-    return;
-  }
-  // process response later
-  self.m_httpResponse = (NSHTTPURLResponse*)aResponse;
-  // with redirects this variable gets recreated (clearing any previous received
-  // data)
-  self.m_responseData = [[NSMutableData alloc] init];
-#ifdef IQUSDK_DEBUG
-  [[IQUSDK instance]
-      addLog:[NSString
-                 stringWithFormat:@"[Network][Response] code = %d (%@)", self.m_httpResponse.statusCode,
-                                  [NSHTTPURLResponse localizedStringForStatusCode:self.m_httpResponse.statusCode]]];
-  [[IQUSDK instance]
-      addLog:[NSString stringWithFormat:@"[Network][Response] headers = %@", self.m_httpResponse.allHeaderFields]];
-#endif
-}
-
-/**
-  Implements the connection:didReceiveData method.
-*/
-- (void)connection:(NSURLConnection*)aConnection didReceiveData:(NSData*)aData {
-  // ignore if it is not the current connection
-  if (aConnection != self.m_connection) {
-    return;
-  }
-  // Append the new data to the instance variable you declared
-  [self.m_responseData appendData:aData];
-}
-
-/**
-  Implements the connection:willCacheResponse method.
-*/
-- (NSCachedURLResponse*)connection:(NSURLConnection*)aConnection
-                 willCacheResponse:(NSCachedURLResponse*)aCachedResponse {
-  // Return nil to indicate not necessary to store a cached response for this
-  // connection
-  return nil;
-}
-
-/**
-  Implements the connectionDidFinishLoading method.
-*/
-- (void)connectionDidFinishLoading:(NSURLConnection*)aConnection {
-  // ignore if it is not the current connection
-  if (aConnection != self.m_connection) {
-    return;
-  }
-  // parse received data as JSON
-  NSError* jsonError;
-  NSMutableDictionary* result = [NSJSONSerialization JSONObjectWithData:self.m_responseData
-                                                                options:NSJSONReadingMutableContainers
-                                                                  error:&jsonError];
-  if (result == nil) {
-    result = [[NSMutableDictionary alloc] initWithCapacity:2];
-    if (jsonError == nil) {
-      [result setObject:@"error in json data received" forKey:ERROR];
+- (NSArray*)parseResults:(NSArray*)aResults count:(int)aCount {
+  NSMutableArray* result = [[NSMutableArray alloc] initWithCapacity:aCount];
+  for (int index = 0; index < aCount; index++) {
+    id status = (index < aResults.count) ? [aResults objectAtIndex:index] : nil;
+    if ([status isKindOfClass:[NSDictionary class]]) {
+      status = [status valueForKey:@"status"];
+    }
+    if ([@"ok" isEqual:status]) {
+      [result addObject:@(IQUSDKMessageResultAccepted)];
+    } else if ([@"rejected" isEqual:status]) {
+      [result addObject:@(IQUSDKMessageResultRejected)];
     } else {
-      [result setObject:jsonError.localizedDescription forKey:ERROR];
+      [result addObject:@(IQUSDKMessageResultRetry)];
     }
   }
-  // add status code from http response (if any)
-  [self addStatusCode:result];
-  // store
-  self.m_result = result;
-}
-
-/**
-  Implements the connection:didFailWithError method.
-*/
-- (void)connection:(NSURLConnection*)aConnection didFailWithError:(NSError*)anError {
-  // ignore if it is not the current connection
-  if (aConnection != self.m_connection) {
-    return;
-  }
-  NSMutableDictionary* result = [[NSMutableDictionary alloc] initWithCapacity:2];
-  if (anError == nil) {
-    [result setObject:@"unknown error occured (error == nil)" forKey:ERROR];
-  } else {
-    [result setObject:anError.localizedDescription forKey:ERROR];
-  }
-  // add status code from http response (if any)
-  [self addStatusCode:result];
-  // store result
-  self.m_result = result;
+  return result;
 }
 
 @end
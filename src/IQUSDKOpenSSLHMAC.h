@@ -0,0 +1,11 @@
+#import <Foundation/Foundation.h>
+#import "IQUSDKHMAC.h"
+
+#pragma mark - INTERFACE
+
+/**
+  IQUSDKOpenSSLHMAC implements IQUSDKHMAC using OpenSSL (libcrypto). Only available when IQUSDK_OPENSSL is defined.
+*/
+@interface IQUSDKOpenSSLHMAC : NSObject<IQUSDKHMAC>
+
+@end
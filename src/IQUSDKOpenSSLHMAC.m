@@ -0,0 +1,35 @@
+#import "IQUSDKConfig.h"
+#ifdef IQUSDK_OPENSSL
+#import <openssl/evp.h>
+#import <openssl/hmac.h>
+#import <string.h>
+#import "IQUSDKOpenSSLHMAC.h"
+#import "IQUSDKUtils.h"
+
+#pragma mark - PRIVATE DEFINITIONS
+
+@interface IQUSDKOpenSSLHMAC ()
+@end
+
+#pragma mark - IMPLEMENTATION
+
+@implementation IQUSDKOpenSSLHMAC
+
+#pragma mark - IQUSDKHMAC
+
+/**
+  Implements the sha512 method.
+*/
+- (NSString*)sha512:(NSString*)aText withKey:(NSString*)aKey {
+  const char* key = [aKey cStringUsingEncoding:NSUTF8StringEncoding];
+  const char* data = [aText cStringUsingEncoding:NSUTF8StringEncoding];
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int length = 0;
+  if (HMAC(EVP_sha512(), key, (int)strlen(key), (const unsigned char*)data, strlen(data), digest, &length) == NULL) {
+    return @"";
+  }
+  return [IQUSDKUtils toHex:digest length:length];
+}
+
+@end
+#endif
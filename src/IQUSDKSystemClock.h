@@ -0,0 +1,11 @@
+#import <Foundation/Foundation.h>
+#import "IQUSDKClock.h"
+
+#pragma mark - INTERFACE
+
+/**
+  IQUSDKSystemClock implements IQUSDKClock using the real system time. This is the clock used by default.
+*/
+@interface IQUSDKSystemClock : NSObject<IQUSDKClock>
+
+@end
@@ -0,0 +1,36 @@
+#import "IQUSDKConfig.h"
+#import "IQUSDKSystemClock.h"
+
+#pragma mark - PRIVATE DEFINITIONS
+
+@interface IQUSDKSystemClock ()
+@end
+
+#pragma mark - IMPLEMENTATION
+
+@implementation IQUSDKSystemClock
+
+#pragma mark - IQUSDKClock
+
+/**
+  Implements the currentTimeMillis method.
+*/
+- (int64_t)currentTimeMillis {
+  return (int64_t)([[NSDate date] timeIntervalSince1970] * 1000.0);
+}
+
+/**
+  Implements the sleep method.
+*/
+- (void)sleep:(int64_t)aMilliseconds {
+  [NSThread sleepForTimeInterval:((NSTimeInterval)aMilliseconds) / 1000];
+}
+
+/**
+  Implements the wait:timeout method.
+*/
+- (bool)wait:(dispatch_semaphore_t)aSemaphore timeout:(int64_t)aMilliseconds {
+  return dispatch_semaphore_wait(aSemaphore, dispatch_time(DISPATCH_TIME_NOW, aMilliseconds * (int64_t)NSEC_PER_MSEC)) == 0;
+}
+
+@end
@@ -0,0 +1,53 @@
+#import <Foundation/Foundation.h>
+
+#pragma mark - Consts
+
+/**
+  The key value for the status code in the result returned by a transport.
+*/
+extern NSString* const IQUSDKTransportCodeKey;
+
+/**
+  The key value for errors in the result returned by a transport.
+*/
+extern NSString* const IQUSDKTransportErrorKey;
+
+/**
+  The key value for the data received from the server in the result returned by a transport.
+*/
+extern NSString* const IQUSDKTransportDataKey;
+
+#pragma mark - INTERFACE
+
+/**
+  IQUSDKTransport defines the HTTP backend used by IQUSDKNetwork to communicate with the server. The send method is 
+  called from a separate thread and blocks until the IO action has finished.
+*/
+@protocol IQUSDKTransport<NSObject>
+
+/**
+  Sends a request to the server and waits for the response.
+ 
+  The result contains IQUSDKTransportCodeKey with the HTTP status code (if a response was received). If the request
+  was successful the result contains IQUSDKTransportDataKey with the received data, else it contains 
+  IQUSDKTransportErrorKey with an error description.
+ 
+  @param anURL URL to send request to
+  @param aPostContent JSON formatted POST content to send or nil to perform a GET request.
+  @param aTimeout Maximum time in milliseconds the request may take.
+ 
+  @return NSDictionary with result
+*/
+- (NSDictionary*)send:(NSString*)anURL postContent:(NSString*)aPostContent timeout:(int)aTimeout;
+
+/**
+  Cancels current IO (if any). This method can be called from other threads.
+*/
+- (void)cancel;
+
+/**
+  Cleans up references and resources.
+*/
+- (void)destroy;
+
+@end
@@ -0,0 +1,12 @@
+#import <Foundation/Foundation.h>
+#import "IQUSDKTransport.h"
+
+#pragma mark - INTERFACE
+
+/**
+  IQUSDKURLConnectionTransport implements IQUSDKTransport using NSURLConnection. Only available when 
+  IQUSDK_URLCONNECTION is defined.
+*/
+@interface IQUSDKURLConnectionTransport : NSObject<IQUSDKTransport>
+
+@end
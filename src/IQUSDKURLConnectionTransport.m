@@ -0,0 +1,338 @@
+#import "IQUSDKConfig.h"
+#ifdef IQUSDK_URLCONNECTION
+#import "IQUSDKURLConnectionTransport.h"
+#import "IQUSDK.h"
+
+#pragma mark - PRIVATE DEFINITIONS
+
+@interface IQUSDKURLConnectionTransport ()
+
+#pragma mark - Private properties
+
+/**
+  When true cancel any active IO running.
+*/
+@property bool m_cancel;
+
+/**
+  Result of an URL request.
+*/
+@property NSDictionary* m_result;
+
+/**
+  Data received from server.
+*/
+@property NSMutableData* m_responseData;
+
+/**
+  Response received.
+*/
+@property NSHTTPURLResponse* m_httpResponse;
+
+/**
+  Will contain the current active connection.
+*/
+@property NSURLConnection* m_connection;
+
+#pragma mark - Private methods
+
+/**
+   Creates a request from an URL and optional POST data.
+
+   @param anURL        URL to send request to
+   @param aPostContent POST data or nil if there is no POST data.
+   @param aTimeout     Time-out in milliseconds
+
+   @return NSURLRequest instance.
+*/
+- (NSURLRequest*)createRequest:(NSString*)anURL postContent:(NSString*)aPostContent timeout:(int)aTimeout;
+
+/**
+   Sends data to the server.
+
+   @param aRequest Request contains the URL and optional POST data.
+   @param aTimeout Time-out in milliseconds
+*/
+- (void)sendData:(NSURLRequest*)aRequest timeout:(int)aTimeout;
+
+/**
+   Checks if a http response was received and add statusCode to the dictionary if it did.
+
+   @param aDictionary Dictionary to add code to (if any)
+*/
+- (void)addStatusCode:(NSMutableDictionary*)aDictionary;
+
+#pragma mark - NSURLConnection callbacks
+
+/**
+  This method is called from NSURLConnection and handles the response received from the server.
+
+  @param aConnection Connection calling this method.
+  @param aResponse   Response received from the server.
+*/
+- (void)connection:(NSURLConnection*)aConnection didReceiveResponse:(NSURLResponse*)aResponse;
+
+/**
+  This method is called from NSURLConnction and handles any data received from the server.
+
+  @param aConnection Connection calling this method.
+  @param aData       Data received from the server.
+*/
+- (void)connection:(NSURLConnection*)aConnection didReceiveData:(NSData*)aData;
+
+/**
+  This method is called from NSURLConnection, it just returns nil to disable any caching.
+
+  @param aConnection     Connection calling this method.
+  @param aCachedResponse NSCachedURLResponse instance.
+
+  @return will return nil
+*/
+- (NSCachedURLResponse*)connection:(NSURLConnection*)aConnection
+                 willCacheResponse:(NSCachedURLResponse*)aCachedResponse;
+
+/**
+   This method is called from NSURLConnection when all response data has been received successfully.
+
+   @param aConnection Connection calling this method.
+*/
+- (void)connectionDidFinishLoading:(NSURLConnection*)aConnection;
+
+/**
+   This method is called from NSURLConnection and handles any error that occurred.
+
+   @param aConnection Connection calling this method
+   @param anError     Error that occurred
+*/
+- (void)connection:(NSURLConnection*)aConnection didFailWithError:(NSError*)anError;
+
+@end
+
+#pragma mark - IMPLEMENTATION
+
+@implementation IQUSDKURLConnectionTransport
+
+#pragma mark - Initializers
+
+/**
+  Initializes the instance.
+*/
+- (instancetype)init {
+  self = [super init];
+  if (self != nil) {
+    self.m_cancel = false;
+  }
+  return self;
+}
+
+#pragma mark - IQUSDKTransport
+
+/**
+  Implements the send method.
+*/
+- (NSDictionary*)send:(NSString*)anURL postContent:(NSString*)aPostContent timeout:(int)aTimeout {
+  // create request
+  NSURLRequest* request = [self createRequest:anURL postContent:aPostContent timeout:aTimeout];
+  // perform IO and wait for it to finish
+  [self sendData:request timeout:aTimeout];
+  // reset cancel for next time
+  self.m_cancel = false;
+  // done
+  NSDictionary* result = self.m_result;
+  self.m_result = nil;
+  return result;
+}
+
+/**
+  Implements the cancel method.
+*/
+- (void)cancel {
+  self.m_cancel = true;
+}
+
+/**
+  Implements the destroy method.
+*/
+- (void)destroy {
+  // stop any io
+  self.m_cancel = true;
+  // clear reference to connection
+  self.m_connection = nil;
+  self.m_httpResponse = nil;
+  self.m_responseData = nil;
+  self.m_result = nil;
+}
+
+#pragma mark - Private methods
+
+/**
+  Implements the createRequest method.
+*/
+- (NSURLRequest*)createRequest:(NSString*)anURL postContent:(NSString*)aPostContent timeout:(int)aTimeout {
+  // create the request
+  NSMutableURLRequest* request =
+      [NSMutableURLRequest requestWithURL:[NSURL URLWithString:anURL]
+                              cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
+                          timeoutInterval:((NSTimeInterval)aTimeout) / 1000];
+  // initialize request without or with POST content
+  if (aPostContent == nil) {
+    // no post content, so use GET
+    request.HTTPMethod = @"GET";
+  } else {
+    // do post request for parameter passing
+    request.HTTPMethod = @"POST";
+    // set the content type to JSON
+    [request setValue:@"application/json" forHTTPHeaderField:@"Content-Type"];
+    // set body
+    request.HTTPBody = [aPostContent dataUsingEncoding:NSUTF8StringEncoding];
+    // store length of POST data
+    NSString* postLength = [NSString stringWithFormat:@"%d", request.HTTPBody.length];
+    [request setValue:postLength forHTTPHeaderField:@"Content-Length"];
+  }
+  // set SDK version and type in header
+  [request addValue:@IQUSDK_VERSION forHTTPHeaderField:@"SdkVersion"];
+  [request addValue:@IQUSDK_TYPE forHTTPHeaderField:@"SdkType"];
+  return request;
+}
+
+/**
+  Implements the sendData method.
+*/
+- (void)sendData:(NSURLRequest*)aRequest timeout:(int)aTimeout {
+  // reset vars (some will be set by the delegate callbacks)
+  self.m_result = nil;
+  self.m_responseData = nil;
+  self.m_httpResponse = nil;
+  self.m_connection = nil;
+  // get end time; IO always takes real time, so don't use the (possibly simulated) SDK clock
+  NSDate* endTime = [NSDate dateWithTimeIntervalSinceNow:((NSTimeInterval)aTimeout) / 1000];
+  // create connection using a separate queue
+  dispatch_queue_t downloadQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+  dispatch_async(downloadQueue, ^{
+    // create connection and start sending data
+    self.m_connection = [[NSURLConnection alloc] initWithRequest:aRequest delegate:self startImmediately:YES];
+    // connection was not created?
+    if (self.m_connection == nil) {
+      // set result
+      self.m_result = @{ IQUSDKTransportErrorKey : @"error: connection could not be created." };
+    }
+    [[NSRunLoop currentRunLoop] run];
+  });
+  // wait till either IO has finished, IO is cancelled or time-out has occurred
+  while ((self.m_result == nil) && !self.m_cancel && ([endTime timeIntervalSinceNow] > 0)) {
+    [NSThread sleepForTimeInterval:0.01];
+  }
+  // connection was not reset while busy?
+  if (self.m_connection != nil) {
+    // cancel io
+    [self.m_connection cancel];
+  }
+  // clear references
+  self.m_connection = nil;
+  self.m_responseData = nil;
+  self.m_httpResponse = nil;
+  // cancelled?
+  if (self.m_cancel) {
+    self.m_result = @{ IQUSDKTransportErrorKey : @"error: io was cancelled." };
+  }
+  // not finished?
+  else if (self.m_result == nil) {
+    self.m_result = @{ IQUSDKTransportErrorKey : @"error: io did not finish in time (timeout error)." };
+  }
+}
+
+/**
+  Implements the addStatusCode method.
+*/
+- (void)addStatusCode:(NSMutableDictionary*)aDictionary {
+  // received http response?
+  if (self.m_httpResponse != nil) {
+    [aDictionary setObject:@(self.m_httpResponse.statusCode) forKey:IQUSDKTransportCodeKey];
+  }
+}
+
+#pragma mark - NSURLConnection callbacks
+
+/**
+  Implements the connection:didReceiveResponse method.
+*/
+- (void)connection:(NSURLConnection*)aConnection didReceiveResponse:(NSURLResponse*)aResponse {
+  // ignore if it is not the current connection
+  if (aConnection != self.m_connection) {
+    return;
+  }
+  // process response later
+  self.m_httpResponse = (NSHTTPURLResponse*)aResponse;
+  // with redirects this variable gets recreated (clearing any previous received
+  // data)
+  self.m_responseData = [[NSMutableData alloc] init];
+#ifdef IQUSDK_DEBUG
+  [[IQUSDK instance]
+      addLog:[NSString
+                 stringWithFormat:@"[Network][Response] code = %d (%@)", self.m_httpResponse.statusCode,
+                                  [NSHTTPURLResponse localizedStringForStatusCode:self.m_httpResponse.statusCode]]];
+  [[IQUSDK instance]
+      addLog:[NSString stringWithFormat:@"[Network][Response] headers = %@", self.m_httpResponse.allHeaderFields]];
+#endif
+}
+
+/**
+  Implements the connection:didReceiveData method.
+*/
+- (void)connection:(NSURLConnection*)aConnection didReceiveData:(NSData*)aData {
+  // ignore if it is not the current connection
+  if (aConnection != self.m_connection) {
+    return;
+  }
+  // Append the new data to the instance variable you declared
+  [self.m_responseData appendData:aData];
+}
+
+/**
+  Implements the connection:willCacheResponse method.
+*/
+- (NSCachedURLResponse*)connection:(NSURLConnection*)aConnection
+                 willCacheResponse:(NSCachedURLResponse*)aCachedResponse {
+  // Return nil to indicate not necessary to store a cached response for this
+  // connection
+  return nil;
+}
+
+/**
+  Implements the connectionDidFinishLoading method.
+*/
+- (void)connectionDidFinishLoading:(NSURLConnection*)aConnection {
+  // ignore if it is not the current connection
+  if (aConnection != self.m_connection) {
+    return;
+  }
+  NSMutableDictionary* result = [[NSMutableDictionary alloc] initWithCapacity:2];
+  [result setObject:self.m_responseData forKey:IQUSDKTransportDataKey];
+  // add status code from http response (if any)
+  [self addStatusCode:result];
+  // store
+  self.m_result = result;
+}
+
+/**
+  Implements the connection:didFailWithError method.
+*/
+- (void)connection:(NSURLConnection*)aConnection didFailWithError:(NSError*)anError {
+  // ignore if it is not the current connection
+  if (aConnection != self.m_connection) {
+    return;
+  }
+  NSMutableDictionary* result = [[NSMutableDictionary alloc] initWithCapacity:2];
+  if (anError == nil) {
+    [result setObject:@"unknown error occured (error == nil)" forKey:IQUSDKTransportErrorKey];
+  } else {
+    [result setObject:anError.localizedDescription forKey:IQUSDKTransportErrorKey];
+  }
+  // add status code from http response (if any)
+  [self addStatusCode:result];
+  // store result
+  self.m_result = result;
+}
+
+@end
+#endif
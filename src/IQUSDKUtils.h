@@ -1,4 +1,5 @@
 #import <Foundation/Foundation.h>
+#import "IQUSDKClock.h"
 
 #pragma mark - INTERFACE
 
@@ -10,12 +11,55 @@
 #pragma mark - Public methods
 
 /**
-  Returns the time passed in milliseconds since 1970-01-01 00:00:00.000
+  Returns the time passed in milliseconds since 1970-01-01 00:00:00.000 using the active clock.
  
   @return time in milliseconds
 */
 + (int64_t)currentTimeMillis;
 
+/**
+  Blocks the calling thread for a certain time using the active clock.
+ 
+  @param aMilliseconds Time to sleep in milliseconds.
+*/
++ (void)sleep:(int64_t)aMilliseconds;
+
+/**
+  Waits for a semaphore to get signalled or until a time-out has occurred using the active clock.
+ 
+  @param aSemaphore Semaphore to wait for.
+  @param aMilliseconds Maximum time to wait in milliseconds.
+ 
+  @return <code>true</code> if the semaphore got signalled, <code>false</code> if a time-out occurred.
+*/
++ (bool)wait:(dispatch_semaphore_t)aSemaphore timeout:(int64_t)aMilliseconds;
+
+/**
+  Returns the active clock.
+ 
+  @return IQUSDKClock implementation
+*/
++ (id<IQUSDKClock>)clock;
+
+/**
+  Sets the clock used by the SDK for all time related actions. Use nil to use the system clock again.
+ 
+  This method must be called before the SDK is started; the clock is read without locking.
+ 
+  @param aClock IQUSDKClock implementation or nil for the system clock.
+*/
++ (void)setClock:(id<IQUSDKClock>)aClock;
+
+/**
+  Converts bytes to a lowercase hex string.
+ 
+  @param aBytes Bytes to convert
+  @param aLength Number of bytes
+ 
+  @return hex string containing two characters per byte.
+*/
++ (NSString*)toHex:(const unsigned char*)aBytes length:(NSUInteger)aLength;
+
 /**
   Convert a NSDictionary to a JSON formatted string. If IQUSDK_DEBUG is defined use pretty printing, else return compact version.
 */
@@ -1,5 +1,6 @@
 #import "IQUSDKConfig.h"
 #import "IQUSDKUtils.h"
+#import "IQUSDKSystemClock.h"
 
 #pragma mark - PRIVATE DEFINITIONS
 
@@ -10,13 +11,67 @@
 
 @implementation IQUSDKUtils
 
+#pragma mark - Private static variables
+
+/**
+  Active clock, nil until it is used or set for the first time. It is read without locking, since it is only changed
+  before the SDK is started.
+*/
+static id<IQUSDKClock> __strong m_clock = nil;
+
 #pragma mark - Public methods
 
 /**
   Implements the currentTimeMillis method.
 */
 + (int64_t)currentTimeMillis {
-  return (int64_t)([[NSDate date] timeIntervalSince1970] * 1000.0);
+  return [[self clock] currentTimeMillis];
+}
+
+/**
+  Implements the sleep method.
+*/
++ (void)sleep:(int64_t)aMilliseconds {
+  [[self clock] sleep:aMilliseconds];
+}
+
+/**
+  Implements the wait:timeout method.
+*/
++ (bool)wait:(dispatch_semaphore_t)aSemaphore timeout:(int64_t)aMilliseconds {
+  return [[self clock] wait:aSemaphore timeout:aMilliseconds];
+}
+
+/**
+  Implements the clock method.
+*/
++ (id<IQUSDKClock>)clock {
+  static dispatch_once_t clockInitialized;
+  dispatch_once(&clockInitialized, ^{
+    // use system clock unless a clock was set before
+    if (m_clock == nil) {
+      m_clock = [[IQUSDKSystemClock alloc] init];
+    }
+  });
+  return m_clock;
+}
+
+/**
+  Implements the setClock method.
+*/
++ (void)setClock:(id<IQUSDKClock>)aClock {
+  m_clock = (aClock == nil) ? [[IQUSDKSystemClock alloc] init] : aClock;
+}
+
+/**
+  Implements the toHex method.
+*/
++ (NSString*)toHex:(const unsigned char*)aBytes length:(NSUInteger)aLength {
+  NSMutableString* result = [NSMutableString stringWithCapacity:aLength * 2];
+  for (NSUInteger index = 0; index < aLength; index++) {
+    [result appendFormat:@"%02x", aBytes[index]];
+  }
+  return result;
 }
 
 /**
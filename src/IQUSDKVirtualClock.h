@@ -0,0 +1,37 @@
+#import <Foundation/Foundation.h>
+#import "IQUSDKClock.h"
+
+#pragma mark - INTERFACE
+
+/**
+  IQUSDKVirtualClock implements IQUSDKClock using a simulated time. Sleeping or waiting does not block, instead the 
+  simulated time is advanced with the time that would have been spent.
+ 
+  Install an instance via [IQUSDKUtils setClock:] to run hours of SDK behaviour (heartbeats, server checks, retries) in
+  seconds. Combine it with [IQUSDK instance].testMode to simulate the server being available or off-line.
+ 
+  The time is shared by all threads, so every thread sleeping or waiting advances the time for all threads. The clock
+  is meant for simulations where the update thread is the only thread waiting for time to pass.
+ 
+  Every sleep or wait still blocks for 1 millisecond of real time to prevent a waiting thread from using a full core.
+  Network IO is not affected by this clock; its time-outs are always measured in real time.
+*/
+@interface IQUSDKVirtualClock : NSObject<IQUSDKClock>
+
+#pragma mark - Public methods
+
+/**
+  Initializes the instance using a certain start time.
+ 
+  @param aStartTime Initial time in milliseconds since 1970-01-01 00:00:00.000
+*/
+- (instancetype)init:(int64_t)aStartTime;
+
+/**
+  Advances the simulated time.
+ 
+  @param aMilliseconds Time to advance in milliseconds.
+*/
+- (void)advance:(int64_t)aMilliseconds;
+
+@end
@@ -0,0 +1,92 @@
+#import "IQUSDKConfig.h"
+#import "IQUSDKVirtualClock.h"
+
+#pragma mark - PRIVATE DEFINITIONS
+
+@interface IQUSDKVirtualClock ()
+
+#pragma mark - Private properties
+
+/**
+  Current simulated time.
+*/
+@property int64_t m_time;
+
+@end
+
+#pragma mark - IMPLEMENTATION
+
+@implementation IQUSDKVirtualClock
+
+#pragma mark - Private consts
+
+/**
+  Real time (in seconds) a thread sleeps every time it sleeps or waits for the simulated time.
+*/
+static const NSTimeInterval RealSleepTime = 0.001;
+
+#pragma mark - Initializers
+
+/**
+  Initializes the instance using the current system time as start time.
+*/
+- (instancetype)init {
+  return [self init:(int64_t)([[NSDate date] timeIntervalSince1970] * 1000.0)];
+}
+
+/**
+  Implements the init method.
+*/
+- (instancetype)init:(int64_t)aStartTime {
+  self = [super init];
+  if (self != nil) {
+    self.m_time = aStartTime;
+  }
+  return self;
+}
+
+#pragma mark - Public methods
+
+/**
+  Implements the advance method.
+*/
+- (void)advance:(int64_t)aMilliseconds {
+  @synchronized(self) {
+    self.m_time += aMilliseconds;
+  }
+}
+
+#pragma mark - IQUSDKClock
+
+/**
+  Implements the currentTimeMillis method.
+*/
+- (int64_t)currentTimeMillis {
+  @synchronized(self) {
+    return self.m_time;
+  }
+}
+
+/**
+  Implements the sleep method.
+*/
+- (void)sleep:(int64_t)aMilliseconds {
+  [self advance:aMilliseconds];
+  // give other threads a chance to run; use a short real sleep so a thread looping on sleep or wait does not keep a
+  // core busy
+  [NSThread sleepForTimeInterval:RealSleepTime];
+}
+
+/**
+  Implements the wait:timeout method.
+*/
+- (bool)wait:(dispatch_semaphore_t)aSemaphore timeout:(int64_t)aMilliseconds {
+  // semaphore already signalled?
+  if (dispatch_semaphore_wait(aSemaphore, DISPATCH_TIME_NOW) == 0) {
+    return true;
+  }
+  [self sleep:aMilliseconds];
+  return false;
+}
+
+@end
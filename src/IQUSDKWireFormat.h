@@ -0,0 +1,21 @@
+#import <Foundation/Foundation.h>
+
+/**
+  IQUSDKWireFormat defines the formats that can be used to send messages to the server.
+*/
+typedef NS_ENUM(NSInteger, IQUSDKWireFormat) {
+  /**
+    Array with an object per message containing the ids and the event:
+
+        [{"identifiers":{..},"event":{..}},..]
+  */
+  IQUSDKWireFormatList = 0,
+
+  /**
+    Object containing every distinct set of ids once and an array with an object per message, referring to the ids by
+    index:
+
+        {"identifiers":[{..},..],"messages":[{"identifiers":0,"event":{..}},..]}
+  */
+  IQUSDKWireFormatGrouped = 1
+};